@@ -1,5 +1,7 @@
-import os
+import glob
 import math
+import os
+import re
 
 PROJECT_ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
 
@@ -88,5 +90,467 @@ def note_dphase_lut(size=128):
     ], "build/note_dphase_lut.h", includes=["<stdint.h>"])
 
 
+# easing curves, order must match ease_t in src/shared/ease.h
+EASE_TABLE_BITS = 7  # keep in sync with src/shared/ease.h
+
+
+def _ease_out_bounce(t):
+    n, d = 7.5625, 2.75
+    if t < 1 / d:
+        return n * t * t
+    if t < 2 / d:
+        t -= 1.5 / d
+        return n * t * t + 0.75
+    if t < 2.5 / d:
+        t -= 2.25 / d
+        return n * t * t + 0.9375
+    t -= 2.625 / d
+    return n * t * t + 0.984375
+
+
+def _ease_out_elastic(t):
+    if t <= 0 or t >= 1:
+        return t
+    return math.pow(2, -10 * t) * math.sin((t * 10 - 0.75) * (2 * math.pi / 3)) + 1
+
+
+_BACK = 1.70158
+
+EASE_CURVES = [
+    ("LINEAR", lambda t: t),
+    ("IN_QUAD", lambda t: t * t),
+    ("OUT_QUAD", lambda t: 1 - (1 - t) ** 2),
+    ("INOUT_QUAD", lambda t: 2 * t * t if t < 0.5 else 1 - 2 * (1 - t) ** 2),
+    ("IN_CUBIC", lambda t: t**3),
+    ("OUT_CUBIC", lambda t: 1 - (1 - t) ** 3),
+    ("INOUT_CUBIC", lambda t: 4 * t**3 if t < 0.5 else 1 - 4 * (1 - t) ** 3),
+    ("IN_BACK", lambda t: (_BACK + 1) * t**3 - _BACK * t * t),
+    ("OUT_BACK", lambda t: 1 + (_BACK + 1) * (t - 1) ** 3 + _BACK * (t - 1) ** 2),
+    ("OUT_ELASTIC", _ease_out_elastic),
+    ("OUT_BOUNCE", _ease_out_bounce),
+    ("IN_BOUNCE", lambda t: 1 - _ease_out_bounce(1 - t)),
+]
+
+
+def ease_tables():
+    """Bake every curve into a Q16.16 table, sampled at 2^EASE_TABLE_BITS + 1
+    points from t = 0 to 1. src/shared/ease.c interpolates between them."""
+    size = (1 << EASE_TABLE_BITS) + 1
+    # only ease.c includes this, so the tables exist once in the firmware
+    segments = [
+        "// included by src/shared/ease.c only, after ease.h\n"
+        f"#if EASE_TABLE_BITS != {EASE_TABLE_BITS}\n"
+        '#error "EASE_TABLE_BITS in ease.h does not match scripts/bake.py"\n'
+        "#endif"
+    ]
+    for name, curve in EASE_CURVES:
+        segments.append(generate_c_table(
+            f"EASE_{name}_TABLE", size,
+            lambda i: round(curve(i / (size - 1)) * 65536),
+            c_type="int32_t", per_line=8,
+        ))
+    segments.append(
+        "const int32_t *const EASE_TABLES[EASE_COUNT] = {\n"
+        + "".join(f"  EASE_{name}_TABLE,\n" for name, _ in EASE_CURVES)
+        + "};"
+    )
+    write_c_header(segments, os.path.join("src", "shared", "ease_tables.h"),
+                   includes=["<stdint.h>"])
+
+
+# event stream commands, must match src/shared/audio/tune.h
+EVENT_NOTE_OFF = 0x80
+EVENT_INSTRUMENT = 0x81
+EVENT_WAIT = 0x82
+EVENT_END = 0xFF
+
+# synth timebase units per second, as passed to audio_synth_init
+MML_TIMEBASE = 1000
+
+MML_NOTES = {"c": 0, "d": 2, "e": 4, "f": 5, "g": 7, "a": 9, "b": 11}
+
+
+def _mml_expand_repeats(text):
+    """Expand [ ... ]n loops (n defaults to 2), innermost first."""
+    pattern = re.compile(r"\[([^\[\]]*)\](\d*)")
+    while True:
+        expanded = pattern.sub(lambda m: m.group(1) * int(m.group(2) or 2), text)
+        if expanded == text:
+            return text
+        text = expanded
+
+
+def _mml_track_events(text, name):
+    """
+    Compile one track of MML into a list of (time, order, note, value)
+    tuples, time in timebase units. Returns (events, total_length).
+
+    Supported commands:
+        cdefgab[+#-][len][.][&len]  note, sharps/flats, length, dots, ties
+        r[len][.]                   rest
+        o<n> < >                    octave set / down / up (o4 c = MIDI 60)
+        l<n>                        default length (4 = quarter note)
+        t<n>                        tempo in quarter notes per minute
+        v<n>                        velocity 0-127
+        q<n>                        gate time in eighths of the note (1-8)
+        @<n>                        instrument index
+        [ ... ]<n>                  repeat n times
+    """
+    text = _mml_expand_repeats(text.lower())
+    pos = 0
+    tempo, octave, length, velocity, gate = 120.0, 4, 4, 100, 8
+    time = 0.0
+    events = []
+
+    def number(default=None):
+        nonlocal pos
+        start = pos
+        while pos < len(text) and text[pos].isdigit():
+            pos += 1
+        if start == pos:
+            if default is None:
+                raise ValueError(f"{name}: expected a number at '{text[start:start + 8]}'")
+            return default
+        return int(text[start:pos])
+
+    def duration():
+        # whole note = 4 quarter notes
+        nonlocal pos
+        value = MML_TIMEBASE * 60.0 * 4 / (tempo * number(length))
+        dot = value
+        while pos < len(text) and text[pos] == ".":
+            dot /= 2
+            value += dot
+            pos += 1
+        return value
+
+    while pos < len(text):
+        c = text[pos]
+        pos += 1
+        if c.isspace() or c == "|":
+            continue
+        if c in MML_NOTES:
+            note = MML_NOTES[c] + (octave + 1) * 12
+            while pos < len(text) and text[pos] in "+#-":
+                note += -1 if text[pos] == "-" else 1
+                pos += 1
+            dur = duration()
+            while pos < len(text) and text[pos] == "&":
+                pos += 1
+                # c4&c8 and c4&8 are both accepted
+                if pos < len(text) and text[pos] in MML_NOTES:
+                    pos += 1
+                    while pos < len(text) and text[pos] in "+#-":
+                        pos += 1
+                dur += duration()
+            if not 0 <= note < 128:
+                raise ValueError(f"{name}: note {note} out of range")
+            events.append((time, 2, note, velocity))
+            events.append((time + dur * gate / 8, 0, EVENT_NOTE_OFF, 0))
+            time += dur
+        elif c == "r":
+            time += duration()
+        elif c == "o":
+            octave = number()
+        elif c == "<":
+            octave -= 1
+        elif c == ">":
+            octave += 1
+        elif c == "l":
+            length = number()
+        elif c == "t":
+            tempo = float(number())
+        elif c == "v":
+            velocity = min(127, number())
+        elif c == "q":
+            gate = max(1, min(8, number()))
+        elif c == "@":
+            events.append((time, 1, EVENT_INSTRUMENT, number()))
+        else:
+            raise ValueError(f"{name}: unknown MML command '{c}'")
+
+    return events, time
+
+
+def _mml_encode(events, total):
+    """Turn absolute-time events into (delta, note, value) triples."""
+    encoded = []
+    last = 0
+    # round absolute times, not deltas, so rounding never accumulates
+    for time, _, note, value in sorted(events, key=lambda e: (round(e[0]), e[1])):
+        delta = round(time) - last
+        last += delta
+        while delta > 0xFFFF:
+            encoded.append((0xFFFF, EVENT_WAIT, 0))
+            delta -= 0xFFFF
+        encoded.append((delta, note, value))
+    delta = max(0, round(total) - last)
+    while delta > 0xFFFF:
+        encoded.append((0xFFFF, EVENT_WAIT, 0))
+        delta -= 0xFFFF
+    encoded.append((delta, EVENT_END, 0))
+    return encoded
+
+
+def compile_mml(source, name):
+    """
+    Compile an .mml file into C definitions of a `tune_<name>`.
+
+    Lines starting with a letter + space are tracks (`A cdef`, lines with the
+    same letter are concatenated), `;` starts a comment, and
+    `#instruments <ident>` / `#loop` are directives.
+    """
+    tracks = {}
+    instruments = None
+    loop = False
+    for line in source.splitlines():
+        line = line.split(";", 1)[0].strip()
+        if not line:
+            continue
+        if line.startswith("#"):
+            directive, *args = line[1:].split()
+            if directive == "instruments":
+                instruments = args[0]
+            elif directive == "loop":
+                loop = True
+            else:
+                raise ValueError(f"{name}: unknown directive #{directive}")
+            continue
+        track, _, body = line.partition(" ")
+        tracks.setdefault(track, []).append(body)
+
+    segments = []
+    track_names = []
+    for index, (track, bodies) in enumerate(sorted(tracks.items())):
+        events, total = _mml_track_events(" ".join(bodies), f"{name}:{track}")
+        encoded = _mml_encode(events, total)
+        track_name = f"tune_{name}_track_{index}"
+        track_names.append(track_name)
+        segments.append(generate_c_table(
+            track_name, len(encoded), lambda i: encoded[i],
+            c_type="audio_synth_event_t", fmt="{{{0[0]}, {0[1]}, {0[2]}}}", per_line=6,
+        ))
+
+    segments.append(
+        f"static const audio_synth_event_t *const tune_{name}_tracks[] = {{\n"
+        + "".join(f"  {track_name},\n" for track_name in track_names)
+        + "};"
+    )
+    instrument_fields = (
+        f"  .instruments = {instruments},\n"
+        f"  .instrument_count = sizeof({instruments}) / sizeof({instruments}[0]),\n"
+        if instruments else ""
+    )
+    segments.append(
+        f"static const audio_synth_tune_t tune_{name} = {{\n"
+        f"  .track_count = {len(track_names)},\n"
+        f"  .tracks = tune_{name}_tracks,\n"
+        + instrument_fields
+        + f"  .loop = {'true' if loop else 'false'},\n"
+        "};"
+    )
+    return segments
+
+
+def app_music():
+    """Bake src/shared/apps/<app>/music/*.mml into <app>/music.h."""
+    apps_dir = os.path.join(PROJECT_ROOT, "src", "shared", "apps")
+    for app in sorted(os.listdir(apps_dir)):
+        music_dir = os.path.join(apps_dir, app, "music")
+        if not os.path.isdir(music_dir):
+            continue
+        segments = []
+        for file in sorted(glob.glob(os.path.join(music_dir, "*.mml"))):
+            name = re.sub(r"[^a-zA-Z0-9_]", "_", os.path.splitext(os.path.basename(file))[0])
+            with open(file) as f:
+                segments += compile_mml(f.read(), name)
+        write_c_header(
+            segments, os.path.join("src", "shared", "apps", app, "music.h"),
+            includes=["shared/audio/tune.h"],
+        )
+
+
+# frames tagged "moving" in Aseprite (<file>_moving_<frame>) are drawn at any
+# y and get one pre-shifted variant per y % 8. the rest, icons and full-screen
+# images, stay put: they only get the aligned variant and are shifted while
+# drawing when they do land off a byte row.
+SPRITE_PRESHIFT_TAG = "moving"
+# aligned sprites at least this tall are RLE compressed
+SPRITE_COMPRESS_MIN_HEIGHT = 64
+
+
+def _xbm_images(source):
+    """Yield (name, width, height, bits) for each XBM image in a header."""
+    sizes = {}
+    for name, axis, value in re.findall(r"#define (\w+)_(width|height) (\d+)", source):
+        sizes.setdefault(name, {})[axis] = int(value)
+    for name, body in re.findall(r"(\w+)_bits\[\] = \{([^}]*)\}", source):
+        bits = [int(v, 16) for v in re.findall(r"0x[0-9a-fA-F]+", body)]
+        yield name, sizes[name]["width"], sizes[name]["height"], bits
+
+
+def _sprite_variant(width, height, bits, shift, rows):
+    """
+    Rows of column bytes as in u8g2's vertical-top-lsb buffer, the image
+    moved down by `shift` pixels. XBM rows are lsb-first horizontal bytes.
+    """
+    stride = (width + 7) // 8
+    out = [0] * (rows * width)
+    for y in range(height):
+        for x in range(width):
+            if bits[y * stride + x // 8] >> (x % 8) & 1:
+                row, bit = divmod(y + shift, 8)
+                out[row * width + x] |= 1 << bit
+    return out
+
+
+def _sprite_rle(data):
+    """
+    PackBits style, see sprite_t: a control byte c < 0x80 is followed by
+    c + 1 literal bytes, c >= 0x80 by one byte repeated (c & 0x7f) + 2 times.
+    """
+    out = []
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < 129:
+            run += 1
+        if run >= 2:
+            out += [0x80 | (run - 2), data[i]]
+            i += run
+            continue
+        end = i + 1
+        while (end < len(data) and end - i < 128
+               and not (end + 1 < len(data) and data[end + 1] == data[end])):
+            end += 1
+        out += [end - i - 1] + data[i:end]
+        i = end
+    return out
+
+
+def sprite_segments(name, width, height, bits, shifts=None):
+    if shifts is None:
+        tag = name.rsplit("_", 2)[-2] if name.count("_") >= 2 else ""
+        shifts = 8 if tag == SPRITE_PRESHIFT_TAG else 1
+    rows = (height + (shifts - 1) + 7) // 8
+    data = []
+    for shift in range(shifts):
+        data += _sprite_variant(width, height, bits, shift, rows)
+    compressed = shifts == 1 and height >= SPRITE_COMPRESS_MIN_HEIGHT
+    if compressed:
+        data = _sprite_rle(data)
+    table = generate_c_table(
+        f"{name}_sprite_bits", len(data), lambda i: data[i], c_type="uint8_t",
+        fmt="0x{:02x}", per_line=12,
+    )
+    return [
+        table,
+        f"static const sprite_t {name}_sprite = {{\n"
+        f"  .width = {width},\n"
+        f"  .height = {height},\n"
+        f"  .rows = {rows},\n"
+        f"  .shifts = {shifts},\n"
+        f"  .compressed = {'true' if compressed else 'false'},\n"
+        f"  .bits = {name}_sprite_bits,\n"
+        "};",
+    ]
+
+
+def _sprite_delta(key, frame, width):
+    """
+    XOR spans turning the key frame into `frame`, see sprite_anim_t: row,
+    column, length and that many XOR bytes, ending with SPRITE_DELTA_END.
+    Changes closer than a span header are joined into one span.
+    """
+    out = []
+    for row in range(len(key) // width):
+        changed = [x for x in range(width)
+                   if key[row * width + x] != frame[row * width + x]]
+        spans = []
+        for x in changed:
+            if spans and x - spans[-1][1] <= 3:
+                spans[-1][1] = x
+            else:
+                spans.append([x, x])
+        for start, end in spans:
+            out += [row, start, end - start + 1]
+            out += [key[row * width + x] ^ frame[row * width + x]
+                    for x in range(start, end + 1)]
+    return out + [0xFF]
+
+
+def _sprite_groups(images):
+    """
+    Group exported frames by the Aseprite file they came from. export.sh
+    names them <file>_<tag>_<frame>.
+    """
+    groups = {}
+    for image in images:
+        groups.setdefault(image[0].rsplit("_", 2)[0], []).append(image)
+    return groups.values()
+
+
+def sprite_anim_segments(name, frames):
+    """One aligned key frame plus a delta per frame, see sprite_anim_t."""
+    width, height = frames[0][1], frames[0][2]
+    rows = (height + 7) // 8
+    data = [_sprite_variant(width, height, bits, 0, rows)
+            for _, w, h, bits in frames]
+    # the frame closest to all others, any change costs two deltas
+    deltas = [[_sprite_delta(key, frame, width) for frame in data]
+              for key in data]
+    key = min(range(len(data)), key=lambda k: sum(map(len, deltas[k])))
+
+    segments = ["\n".join(define(frame[0].upper(), i)
+                           for i, frame in enumerate(frames))]
+    segments += sprite_segments(f"{name}_key", width, height, frames[key][3],
+                                shifts=1)
+    for i, delta in enumerate(deltas[key]):
+        segments.append(generate_c_table(
+            f"{frames[i][0]}_delta", len(delta), lambda j: delta[j],
+            c_type="uint8_t", fmt="0x{:02x}", per_line=12,
+        ))
+    pointers = ",\n".join(f"  {frame[0]}_delta" for frame in frames)
+    segments += [
+        f"static const uint8_t *const {name}_anim_deltas[{len(frames)}] = {{\n"
+        f"{pointers},\n}};",
+        f"static const sprite_anim_t {name}_anim = {{\n"
+        f"  .key = &{name}_key_sprite,\n"
+        f"  .frames = {len(frames)},\n"
+        f"  .deltas = {name}_anim_deltas,\n"
+        "};",
+    ]
+    return segments
+
+
+def app_sprites():
+    """Bake the XBM images of src/shared/apps/<app>/assets.h (written by
+    scripts/export.sh) into sprites in the display buffer layout, in
+    <app>/sprites.h."""
+    apps_dir = os.path.join(PROJECT_ROOT, "src", "shared", "apps")
+    for app in sorted(os.listdir(apps_dir)):
+        assets = os.path.join(apps_dir, app, "assets.h")
+        if not os.path.isfile(assets):
+            continue
+        with open(assets) as f:
+            source = f.read()
+        segments = []
+        for frames in _sprite_groups(_xbm_images(source)):
+            sizes = {(width, height) for _, width, height, _ in frames}
+            if len(frames) > 1 and len(sizes) == 1:
+                name = frames[0][0].rsplit("_", 2)[0]
+                segments += sprite_anim_segments(name, frames)
+            else:
+                for image in frames:
+                    segments += sprite_segments(*image)
+        write_c_header(
+            segments, os.path.join("src", "shared", "apps", app, "sprites.h"),
+            includes=["<stdbool.h>", "<stdint.h>", "shared/sprite.h"],
+        )
+
+
 if __name__ == "__main__":
     note_dphase_lut()
+    ease_tables()
+    app_music()
+    app_sprites()
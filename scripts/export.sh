@@ -7,6 +7,11 @@ cd "$SCRIPT_DIR/.."
 
 shopt -s nullglob
 
+# writes the images as XBM into each app's assets.h. scripts/bake.py then
+# turns them into sprites.h (shared/sprite.h), which is what apps draw, with
+# the frames of each .aseprite file as one delta-encoded animation. tag frames
+# "moving" for sprites drawn at any y, see SPRITE_PRESHIFT_TAG there.
+
 ASEPRITE_CLI="$HOME/Library/Application Support/Steam/steamapps/common/Aseprite/Aseprite.app/Contents/MacOS/aseprite"
 
 for dir in src/shared/apps/*; do
@@ -0,0 +1,376 @@
+"""
+Decode the binary telemetry stream (src/shared/telemetry.h).
+
+Reads from a file written by the host build (--telemetry) or from the device's
+USB serial port, and prints CSV or a live one-line view. Text the firmware
+prints between records is passed through to stderr. With --trace, trace
+captures (src/shared/trace.h) are written as Chrome trace JSON, for
+chrome://tracing or https://ui.perfetto.dev. With --input-log, a session
+recorded from the device menu is written as an input log file, to replay on
+host with mck-parting-c-headless --replay. Profile and memory reports
+(src/shared/profile.h) are printed to stderr as text.
+
+    python scripts/telemetry.py /dev/tty.usbmodem1101 --live
+    python scripts/telemetry.py run.bin > run.csv
+    python scripts/telemetry.py run.bin --trace run.json > /dev/null
+    python scripts/telemetry.py /dev/tty.usbmodem1101 --input-log session.ilog
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+import tty
+
+# keep in sync with telemetry_stats_t
+RECORD_STATS = 1
+STATS_FORMAT = "<BBI12HBB3H"
+STATS_FIELDS = [
+    "type",
+    "version",
+    "time_ms",
+    "fps",
+    "frame_avg_us",
+    "frame_p99_us",
+    "frame_max_us",
+    "synth_avg_load",
+    "synth_p99_load",
+    "synth_peak_load",
+    "synth_overruns",
+    "synth_underruns",
+    "notes",
+    "note_avg_us",
+    "note_peak_us",
+    "battery_level",
+    "power",
+    "midi_dropped",
+    "input_dropped",
+    "telemetry_dropped",
+]
+VERSION = 1
+
+# keep in sync with telemetry_trace_t and trace_id_t
+RECORD_TRACE = 2
+TRACE_HEADER_FORMAT = "<BBBBB"
+TRACE_EVENT_FORMAT = "<IBBH"
+TRACE_EVENTS = 6
+TRACE_NAMES = [
+    "frame",
+    "input",
+    "ticks",
+    "app frame",
+    "menu",
+    "display",
+    "leds",
+    "sleep",
+    "app enter",
+    "app leave",
+    "synth buffer",
+    "audio dma irq",
+    "spi send",
+]
+
+# keep in sync with telemetry_input_log_start_t, telemetry_input_log_t and
+# input_log_entry_t
+RECORD_INPUT_LOG_START = 3
+RECORD_INPUT_LOG = 4
+INPUT_LOG_START_FORMAT = "<BB32sI"
+INPUT_LOG_HEADER_FORMAT = "<BBIB"
+INPUT_LOG_ENTRY_FORMAT = "<HBBI"
+INPUT_LOG_ENTRIES = 6
+
+# keep in sync with telemetry_profile_t, telemetry_memory_t and
+# profile_section_t
+RECORD_PROFILE = 5
+RECORD_MEMORY = 6
+PROFILE_FORMAT = "<BB16sBH6H"
+PROFILE_SECTIONS = ["input", "anim", "tick", "frame", "menu", "display", "leds", "total"]
+MEMORY_FORMAT = "<BB16s9I"
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1 : i + code]
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def decode_trace(raw):
+    header = struct.calcsize(TRACE_HEADER_FORMAT)
+    size = struct.calcsize(TRACE_EVENT_FORMAT)
+    if len(raw) != header + TRACE_EVENTS * size:
+        return None
+    _, _, capture, core, count = struct.unpack_from(TRACE_HEADER_FORMAT, raw)
+    events = [
+        struct.unpack_from(TRACE_EVENT_FORMAT, raw, header + i * size)
+        for i in range(min(count, TRACE_EVENTS))
+    ]
+    return {"type": RECORD_TRACE, "capture": capture, "core": core, "events": events}
+
+
+def decode_input_log(raw):
+    if raw[0] == RECORD_INPUT_LOG_START:
+        if len(raw) != struct.calcsize(INPUT_LOG_START_FORMAT):
+            return None
+        _, _, app, count = struct.unpack(INPUT_LOG_START_FORMAT, raw)
+        return {"type": RECORD_INPUT_LOG_START, "app": app, "count": count}
+    header = struct.calcsize(INPUT_LOG_HEADER_FORMAT)
+    size = struct.calcsize(INPUT_LOG_ENTRY_FORMAT)
+    if len(raw) != header + INPUT_LOG_ENTRIES * size:
+        return None
+    _, _, first, count = struct.unpack_from(INPUT_LOG_HEADER_FORMAT, raw)
+    entries = [raw[header + i * size : header + (i + 1) * size]
+               for i in range(min(count, INPUT_LOG_ENTRIES))]
+    return {"type": RECORD_INPUT_LOG, "first": first, "entries": entries}
+
+
+def decode_report(raw):
+    if raw[0] == RECORD_PROFILE:
+        if len(raw) != struct.calcsize(PROFILE_FORMAT):
+            return None
+        _, _, app, section, frames, *times = struct.unpack(PROFILE_FORMAT, raw)
+        return {"type": RECORD_PROFILE, "app": app.split(b"\0")[0].decode(),
+                "section": section, "frames": frames, "times": times}
+    if len(raw) != struct.calcsize(MEMORY_FORMAT):
+        return None
+    _, _, app, *sizes = struct.unpack(MEMORY_FORMAT, raw)
+    return {"type": RECORD_MEMORY, "app": app.split(b"\0")[0].decode(), "sizes": sizes}
+
+
+def report_text(r):
+    """The profile and memory reports as the firmware used to print them."""
+    if r["type"] == RECORD_MEMORY:
+        arena_used, arena_size, arena_peak, heap, heap_peak, *stacks = r["sizes"]
+        text = (f"memory: {r['app']} arena {arena_used}/{arena_size} (peak {arena_peak}), "
+                f"heap {heap} (peak {heap_peak})")
+        for core in range(2):
+            if stacks[2 + core]:
+                text += f", core{core} stack {stacks[core]}/{stacks[2 + core]}"
+        return text + "\n"
+    section = r["section"]
+    text = ""
+    if section == 0:
+        text = f"profile: {r['app']}, {r['frames']} frames (us: min avg p50 p95 p99 max)\n"
+    name = PROFILE_SECTIONS[section] if section < len(PROFILE_SECTIONS) else f"section {section}"
+    return text + f"  {name:<8}" + "".join(f" {t:5d}" for t in r["times"]) + "\n"
+
+
+def decode_record(chunk):
+    """Return the record dict for a framed chunk, or None if it isn't one."""
+    raw = cobs_decode(chunk)
+    if raw is None or len(raw) < 2 or crc8(raw[:-1]) != raw[-1]:
+        return None
+    raw = raw[:-1]
+    if raw[1] != VERSION:
+        return None
+    if raw[0] == RECORD_TRACE:
+        return decode_trace(raw)
+    if raw[0] in (RECORD_INPUT_LOG_START, RECORD_INPUT_LOG):
+        return decode_input_log(raw)
+    if raw[0] in (RECORD_PROFILE, RECORD_MEMORY):
+        return decode_report(raw)
+    if raw[0] != RECORD_STATS or len(raw) != struct.calcsize(STATS_FORMAT):
+        return None
+    return dict(zip(STATS_FIELDS, struct.unpack(STATS_FORMAT, raw)))
+
+
+class Trace:
+    """Collects trace records into Chrome trace events."""
+
+    def __init__(self):
+        self.events = []
+        self.last = {}  # core -> last raw 32-bit time
+        self.wrap = {}  # core -> time added for wraparounds
+        self.open = {}  # (capture, core) -> {id: begin count}
+        self.end = {}  # (capture, core) -> last time
+
+    def add(self, r):
+        core = r["core"]
+        key = (r["capture"], core)
+        opened = self.open.setdefault(key, {})
+        for raw_us, id, phase, arg in r["events"]:
+            # 32-bit µs timestamps wrap every ~71 minutes
+            if core in self.last and raw_us < self.last[core]:
+                self.wrap[core] = self.wrap.get(core, 0) + (1 << 32)
+            self.last[core] = raw_us
+            ts = raw_us + self.wrap.get(core, 0)
+            self.end[key] = ts
+            name = TRACE_NAMES[id] if id < len(TRACE_NAMES) else f"trace {id}"
+            event = {"name": name, "ph": chr(phase), "ts": ts, "pid": 0, "tid": core}
+            if phase == ord("B"):
+                opened[id] = opened.get(id, 0) + 1
+            elif phase == ord("E"):
+                if not opened.get(id):
+                    continue  # began before the capture
+                opened[id] -= 1
+            else:
+                event["s"] = "t"
+            if arg:
+                event["args"] = {"arg": arg}
+            self.events.append(event)
+
+    def write(self, path):
+        events = list(self.events)
+        # close what was still running when a capture ended
+        for key, opened in self.open.items():
+            for id, count in opened.items():
+                for _ in range(count):
+                    events.append(
+                        {"name": TRACE_NAMES[id] if id < len(TRACE_NAMES) else f"trace {id}",
+                         "ph": "E", "ts": self.end[key], "pid": 0, "tid": key[1]}
+                    )
+        start = min((e["ts"] for e in events), default=0)
+        for e in events:
+            e["ts"] -= start
+        for core in sorted(self.last):
+            events.append(
+                {"name": "thread_name", "ph": "M", "pid": 0, "tid": core,
+                 "args": {"name": f"core{core}"}}
+            )
+        with open(path, "w") as f:
+            json.dump({"traceEvents": events, "displayTimeUnit": "ms"}, f)
+
+
+class InputLog:
+    """Collects a recorded session into an input log file
+    (src/shared/input_log.c)."""
+
+    def __init__(self, path):
+        self.path = path
+        self.app = None
+        self.entries = []
+
+    def add(self, r):
+        if r["type"] == RECORD_INPUT_LOG_START:
+            self.app = r["app"]
+            self.entries = [None] * r["count"]
+            self.check()
+            return
+        if self.app is None:
+            return  # started before we listened
+        for i, entry in enumerate(r["entries"]):
+            if r["first"] + i < len(self.entries):
+                self.entries[r["first"] + i] = entry
+        self.check()
+
+    def check(self):
+        """Write the file once every entry is in."""
+        if self.app is None or None in self.entries:
+            return
+        with open(self.path, "wb") as f:
+            f.write(b"ILOG" + self.app + struct.pack("<I", len(self.entries)))
+            f.write(b"".join(self.entries))
+        app = self.app.split(b"\0")[0].decode()
+        print(f"input log: {len(self.entries)} entries in {app} written to {self.path}",
+              file=sys.stderr)
+        self.app = None
+
+
+def records(stream):
+    """Yield record dicts from a byte stream, passing other text to stderr."""
+    pending = bytearray()
+    while True:
+        data = stream.read(1) if stream.isatty() else stream.read(4096)
+        if not data:
+            break
+        pending += data
+        while True:
+            end = pending.find(0)
+            if end < 0:
+                break
+            chunk = bytes(pending[:end])
+            del pending[: end + 1]
+            if not chunk:
+                continue
+            record = decode_record(chunk)
+            if record is not None:
+                yield record
+            else:
+                sys.stderr.write(chunk.decode("utf-8", "replace"))
+    if pending:
+        sys.stderr.write(pending.decode("utf-8", "replace"))
+
+
+def live_line(r):
+    power = "usb" if r["power"] & 0x01 else "bat"
+    if r["power"] & 0x02:
+        power += "+chg"
+    return (
+        f"{r['time_ms'] / 1000:8.1f}s | fps {r['fps']:3d} | "
+        f"frame {r['frame_avg_us'] / 1000:5.2f} ms "
+        f"(p99 {r['frame_p99_us'] / 1000:5.2f}, max {r['frame_max_us'] / 1000:5.2f}) | "
+        f"synth {r['synth_avg_load']:3d}% (p99 {r['synth_p99_load']}%, "
+        f"peak {r['synth_peak_load']}%) | xrun {r['synth_overruns']}/{r['synth_underruns']} | "
+        f"notes {r['notes']} {r['note_avg_us']} us | "
+        f"{power} {r['battery_level']}% | "
+        f"drop midi {r['midi_dropped']} input {r['input_dropped']} "
+        f"telemetry {r['telemetry_dropped']}"
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("source", help="telemetry file or serial device, - for stdin")
+    parser.add_argument("--live", action="store_true", help="live view instead of CSV")
+    parser.add_argument("--trace", metavar="JSON", help="write trace captures to a Chrome trace file")
+    parser.add_argument("--input-log", metavar="ILOG", help="write a recorded session to an input log file")
+    args = parser.parse_args()
+
+    if args.source == "-":
+        stream = sys.stdin.buffer
+    else:
+        stream = open(args.source, "rb", buffering=0)
+        if stream.isatty():
+            # USB CDC ignores the baud rate, raw mode keeps the bytes intact
+            tty.setraw(stream.fileno())
+
+    trace = Trace() if args.trace else None
+    input_log = InputLog(args.input_log) if args.input_log else None
+    if not args.live:
+        print(",".join(STATS_FIELDS[2:]))
+    try:
+        for r in records(stream):
+            if r["type"] == RECORD_TRACE:
+                if trace is not None:
+                    trace.add(r)
+                continue
+            if r["type"] in (RECORD_INPUT_LOG_START, RECORD_INPUT_LOG):
+                if input_log is not None:
+                    input_log.add(r)
+                continue
+            if r["type"] in (RECORD_PROFILE, RECORD_MEMORY):
+                sys.stderr.write(report_text(r))
+                continue
+            if args.live:
+                sys.stdout.write("\r" + live_line(r))
+            else:
+                print(",".join(str(r[f]) for f in STATS_FIELDS[2:]))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    if args.live:
+        sys.stdout.write(os.linesep)
+    if trace is not None:
+        trace.write(args.trace)
+        print(f"{len(trace.events)} trace events written to {args.trace}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -3,9 +3,12 @@
 #include <pthread.h>
 #include <soundio/soundio.h>
 
+#include <pico/time.h>
+
 #include <shared/audio/buffer.h>
+#include <shared/audio/stats.h>
 #include <shared/audio/synth.h>
-#include <shared/utils/timing.h>
+#include <shared/trace.h>
 
 #include "audio.h"
 #include "config.h"
@@ -13,6 +16,7 @@
 #include "time.h"
 
 static audio_buffer_pool_t pool;
+static uint32_t pool_storage[AUDIO_BUFFER_POOL_SIZE * AUDIO_BUFFER_SIZE];
 
 static inline void _write_frames_from_buffer(struct SoundIoChannelArea **areas,
                                              int frame_count,
@@ -53,7 +57,7 @@ static void audio_playback_write_callback(struct SoundIoOutStream *outstream,
 
   if (frames_left < frame_count_min) {
     // not enough frames to write, lets just wait for more frames
-    printf("audio underflow\n");
+    audio_stats_underrun(&g_audio_stats);
     return;
   }
   if (frames_left > frame_count_max) {
@@ -122,7 +126,7 @@ static void audio_playback_write_callback(struct SoundIoOutStream *outstream,
 
 static void
 audio_playback_underflow_callback(struct SoundIoOutStream *outstream) {
-  fprintf(stderr, "Audio underflow occurred\n");
+  audio_stats_underrun(&g_audio_stats);
 }
 
 // this will be handled by DMA + PIO on device.
@@ -183,18 +187,14 @@ static void audio_playback_main() {
 }
 
 // this will be called on core1 on device.
-void audio_init() {
-  audio_buffer_pool_init(&pool, AUDIO_BUFFER_POOL_SIZE, AUDIO_BUFFER_SIZE);
+void audio_init(audio_synth_t *synth, bool demo) {
+  audio_buffer_pool_init(&pool, pool_storage, AUDIO_BUFFER_POOL_SIZE,
+                         AUDIO_BUFFER_SIZE);
+  audio_stats_init(&g_audio_stats, AUDIO_SAMPLE_RATE, AUDIO_BUFFER_SIZE);
 
   pthread_t audio_playback;
   pthread_create(&audio_playback, NULL, (void *)audio_playback_main, NULL);
 
-  TimingInstrumenter ti_synth;
-
-  audio_synth_t synth;
-  audio_synth_init(&synth, AUDIO_SAMPLE_RATE, 1000);
-  synth.master_level = q1x15_f(0.5f);
-
   audio_synth_operator_config_t config = audio_synth_operator_config_default;
   config.env = (audio_synth_env_config_t){
       .a = 0,
@@ -204,7 +204,8 @@ void audio_init() {
   };
   config.freq_mult = 11;
   config.level = q1x15_f(0.3f);
-  audio_synth_operator_set_config(&synth.voices[0].ops[0], config);
+  for (int voice = 0; voice < AUDIO_SYNTH_VOICE_COUNT; voice++)
+    audio_synth_operator_set_config(&synth->voices[voice].ops[0], config);
 
   config = audio_synth_operator_config_default;
   config.env = (audio_synth_env_config_t){
@@ -215,23 +216,27 @@ void audio_init() {
   };
   config.level = Q1X15_ONE;
   config.mode = AUDIO_SYNTH_OP_MODE_FREQ_MOD;
-  audio_synth_operator_set_config(&synth.voices[0].ops[1], config);
+  for (int voice = 0; voice < AUDIO_SYNTH_VOICE_COUNT; voice++)
+    audio_synth_operator_set_config(&synth->voices[voice].ops[1], config);
 
-  int i = 0;
+  // demo note loop. without it i stays at -1 and notes only come through the
+  // synth's queue (e.g. MIDI input).
+  int i = demo ? 0 : -1;
+  trace_set_core(1); // this thread stands in for core1
   while (true) {
     if (i == 0) {
-      audio_synth_handle_message(&synth,
+      audio_synth_handle_message(synth,
                                  &(audio_synth_message_t){
                                      .type = AUDIO_SYNTH_MESSAGE_NOTE_ON,
                                      .data.note_on =
                                          {
                                              .voice = 0,
-                                             .note_number = note("C4"),
+                                             .note_number = NOTE(C, 4),
                                              .velocity = 127,
                                          },
                                  });
     } else if (i == 10) {
-      audio_synth_handle_message(&synth,
+      audio_synth_handle_message(synth,
                                  &(audio_synth_message_t){
                                      .type = AUDIO_SYNTH_MESSAGE_NOTE_OFF,
                                      .data.note_off =
@@ -240,18 +245,18 @@ void audio_init() {
                                          },
                                  });
     } else if (i == 20) {
-      audio_synth_handle_message(&synth,
+      audio_synth_handle_message(synth,
                                  &(audio_synth_message_t){
                                      .type = AUDIO_SYNTH_MESSAGE_NOTE_ON,
                                      .data.note_on =
                                          {
                                              .voice = 0,
-                                             .note_number = note("D4"),
+                                             .note_number = NOTE(D, 4),
                                              .velocity = 127,
                                          },
                                  });
     } else if (i == 30) {
-      audio_synth_handle_message(&synth,
+      audio_synth_handle_message(synth,
                                  &(audio_synth_message_t){
                                      .type = AUDIO_SYNTH_MESSAGE_NOTE_OFF,
                                      .data.note_off =
@@ -260,18 +265,18 @@ void audio_init() {
                                          },
                                  });
     } else if (i == 40) {
-      audio_synth_handle_message(&synth,
+      audio_synth_handle_message(synth,
                                  &(audio_synth_message_t){
                                      .type = AUDIO_SYNTH_MESSAGE_NOTE_ON,
                                      .data.note_on =
                                          {
                                              .voice = 0,
-                                             .note_number = note("G4"),
+                                             .note_number = NOTE(G, 4),
                                              .velocity = 127,
                                          },
                                  });
     } else if (i == 80) {
-      audio_synth_handle_message(&synth,
+      audio_synth_handle_message(synth,
                                  &(audio_synth_message_t){
                                      .type = AUDIO_SYNTH_MESSAGE_NOTE_OFF,
                                      .data.note_off =
@@ -284,15 +289,15 @@ void audio_init() {
     }
 
     audio_buffer_t buffer = audio_buffer_pool_acquire_write(&pool, true);
-    ti_start(&ti_synth);
-    audio_synth_fill_buffer(&synth, buffer, pool.buffer_size);
-    ti_stop(&ti_synth);
+    uint32_t start_us = time_us_32();
+    trace_begin(TRACE_SYNTH_BUFFER);
+    audio_synth_fill_buffer(synth, buffer, pool.buffer_size);
+    trace_end(TRACE_SYNTH_BUFFER);
+    audio_stats_record(&g_audio_stats, time_us_32() - start_us);
     audio_buffer_pool_commit_write(&pool);
 
-    i += 1;
-    if (i % 1000 == 0) {
-      printf("synth: %f ms\n", ti_get_average_ms(&ti_synth, true));
-    }
+    if (demo)
+      i += 1;
   }
 
   pthread_join(audio_playback, NULL);
@@ -1,3 +1,9 @@
 #pragma once
 
-void audio_init();
+#include <stdbool.h>
+
+#include <shared/audio/synth.h>
+
+// run the synth into the playback stream forever. `demo` plays a short note
+// loop on voice 0, otherwise notes only come from the synth's queue.
+void audio_init(audio_synth_t *synth, bool demo);
@@ -6,6 +6,6 @@
 #if !PICO_ON_DEVICE
 
 // hardware/sync.h
-#define __dmb() ((void)0)
+#define __dmb() __atomic_thread_fence(__ATOMIC_SEQ_CST)
 
 #endif
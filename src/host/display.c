@@ -166,6 +166,7 @@ static void u8g2_SetupSDL_128x64_f(u8g2_t *u8g2) {
 
 void display_init(display_t *display) {
   u8g2_t *u8g2 = display_get_u8g2(display);
+  display_invalidate(display);
   u8g2_SetupSDL_128x64_f(u8g2);
   u8g2_InitDisplay(u8g2);
   u8g2_SetPowerSave(u8g2, 0);
@@ -0,0 +1,74 @@
+#include <u8g2.h>
+
+#include <shared/display.h>
+
+// display without a panel for headless runs. u8g2 draws into its buffer as
+// usual, and tile transfers are counted instead of shown.
+
+uint32_t g_display_headless_tiles;
+
+static const u8x8_display_info_t u8x8_headless_128x64_info = {
+    /* chip_enable_level = */ 0,
+    /* chip_disable_level = */ 1,
+
+    /* post_chip_enable_wait_ns = */ 0,
+    /* pre_chip_disable_wait_ns = */ 0,
+    /* reset_pulse_width_ms = */ 0,
+    /* post_reset_wait_ms = */ 0,
+    /* sda_setup_time_ns = */ 0,
+    /* sck_pulse_width_ns = */ 0,
+    /* sck_clock_hz = */ 0UL,
+    /* spi_mode = */ 1,
+    /* i2c_bus_clock_100kHz = */ 0,
+    /* data_setup_time_ns = */ 0,
+    /* write_pulse_width_ns = */ 0,
+    /* tile_width = */ 16,
+    /* tile_hight = */ 8,
+    /* default_x_offset = */ 0,
+    /* flipmode_x_offset = */ 0,
+    /* pixel_width = */ 128,
+    /* pixel_height = */ 64};
+
+static uint8_t _display_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
+                           void *arg_ptr) {
+  switch (msg) {
+  case U8X8_MSG_DISPLAY_SETUP_MEMORY:
+    u8x8_d_helper_display_setup_memory(u8x8, &u8x8_headless_128x64_info);
+    break;
+  case U8X8_MSG_DISPLAY_INIT:
+    u8x8_d_helper_display_init(u8x8);
+    break;
+  case U8X8_MSG_DISPLAY_DRAW_TILE:
+    g_display_headless_tiles += ((u8x8_tile_t *)arg_ptr)->cnt * arg_int;
+    break;
+  case U8X8_MSG_DISPLAY_REFRESH:
+  case U8X8_MSG_DISPLAY_SET_POWER_SAVE:
+  case U8X8_MSG_DISPLAY_SET_FLIP_MODE:
+  case U8X8_MSG_DISPLAY_SET_CONTRAST:
+    break;
+  default:
+    return 0; // unsupported message
+  }
+  return 1;
+}
+
+void display_init(display_t *display) {
+  u8g2_t *u8g2 = display_get_u8g2(display);
+  display_invalidate(display);
+  u8g2_SetupDisplay(u8g2, _display_cb, u8x8_dummy_cb, u8x8_dummy_cb,
+                    u8x8_dummy_cb);
+  uint8_t tile_buf_height;
+  uint8_t *buf = u8g2_m_16_8_f(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_vertical_top_lsb,
+                   U8G2_R0);
+  u8g2_InitDisplay(u8g2);
+  u8g2_SetPowerSave(u8g2, 0);
+}
+
+void display_set_enabled(display_t *display, bool enabled) {
+  if (display->enabled == enabled)
+    return;
+  display->enabled = enabled;
+  if (enabled)
+    display_invalidate(display);
+}
@@ -0,0 +1,172 @@
+// Headless engine runner.
+// Runs the real engine and apps without a window or audio device, on a
+// virtual clock (vclock.h): every sleep returns at once, so app time runs as
+// fast as the CPU allows. Audio is rendered on the same thread as time
+// passes. Meant for profiling frame(), tick() and the synth with perf or
+// callgrind, and for replaying input logs (shared/input_log.h).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <pico/stdlib.h>
+
+#include <shared/apps/apps.h>
+#include <shared/audio/stats.h>
+#include <shared/config.h>
+#include <shared/engine.h>
+#include <shared/input_log.h>
+#include <shared/telemetry.h>
+#include <shared/trace.h>
+
+#include "config.h"
+#include "vclock.h"
+
+#define INPUT_LOG_CAPACITY 65536
+
+extern uint32_t g_display_headless_tiles;
+
+static app_t *const apps[] = {
+    &app_launcher, &app_full_test, &app_bongocat, &app_dummy, &app_morse,
+};
+
+static input_log_entry_t log_entries[INPUT_LOG_CAPACITY];
+static input_log_t input_log = {.entries = log_entries,
+                                .capacity = INPUT_LOG_CAPACITY};
+
+static struct {
+  uint64_t end_us; // stop once the clock reaches this, 0 = no limit
+  bool replay;     // stop when the replay runs out
+  uint64_t wall_start_ns;
+  uint64_t rendered; // samples
+  uint64_t render_ns;
+  uint64_t render_peak_ns;
+  uint32_t buffers;
+} run;
+
+//// HAL ////
+
+void engine_buttons_init() {}
+
+// no buttons, input only comes from replays
+bool engine_button_read(button_id_t button_id) { return false; }
+
+void engine_sleep_until_interrupt() {}
+
+void audio_playback_set_enabled(bool enabled) {}
+
+// nothing to reset headless
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug) {}
+void watchdog_disable(void) {}
+void watchdog_update(void) {}
+
+//// RUNNER ////
+
+static uint64_t wall_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static app_t *find_app(const char *name) {
+  for (size_t i = 0; i < sizeof(apps) / sizeof(apps[0]); i++) {
+    if (strcmp(apps[i]->name, name) == 0)
+      return apps[i];
+  }
+  fprintf(stderr, "unknown app: %s\n", name);
+  exit(1);
+}
+
+static void finish(uint64_t now_us) {
+  uint64_t wall_us = (wall_ns() - run.wall_start_ns) / 1000;
+  printf("headless: %.3f s in %.3f s wall (%.0fx), %u ticks\n",
+         now_us / 1e6, wall_us / 1e6, wall_us ? (double)now_us / wall_us : 0.0,
+         g_engine.uptime_ticks);
+  printf("headless: synth %u buffers, avg %.1f us, peak %.1f us\n",
+         run.buffers, run.buffers ? run.render_ns / 1e3 / run.buffers : 0.0,
+         run.render_peak_ns / 1e3);
+  printf("headless: display %u tiles sent\n", g_display_headless_tiles);
+  exit(0);
+}
+
+// render the synth up to the current time, timed on the wall clock since the
+// virtual one stands still while we work
+static void render_audio(uint64_t now_us) {
+  static uint32_t buffer[AUDIO_BUFFER_SIZE];
+  uint64_t due = now_us * AUDIO_SAMPLE_RATE / 1000000;
+  trace_set_core(1); // the synth stands in for core1
+  while (due - run.rendered >= AUDIO_BUFFER_SIZE) {
+    uint64_t start = wall_ns();
+    trace_begin(TRACE_SYNTH_BUFFER);
+    audio_synth_fill_buffer(&g_engine.synth, buffer, AUDIO_BUFFER_SIZE);
+    trace_end(TRACE_SYNTH_BUFFER);
+    uint64_t spent = wall_ns() - start;
+    audio_stats_record(&g_audio_stats, (uint32_t)(spent / 1000));
+    run.render_ns += spent;
+    run.render_peak_ns = MAX(run.render_peak_ns, spent);
+    run.buffers++;
+    run.rendered += AUDIO_BUFFER_SIZE;
+  }
+  trace_set_core(0);
+}
+
+static void on_clock(uint64_t now_us) {
+  render_audio(now_us);
+  if ((run.end_us != 0 && now_us >= run.end_us) ||
+      (run.replay && !engine_replay_active()))
+    finish(now_us);
+}
+
+// usage: mck-parting-c-headless [--app name] [--seconds n] [--replay log]
+//                               [--telemetry file]
+// runs for 60 seconds of app time by default, or until the replay ends when
+// replaying without --seconds. telemetry is decoded by scripts/telemetry.py.
+int main(int argc, char **argv) {
+  const char *app_name = NULL;
+  const char *replay_path = NULL;
+  double seconds = 0;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--app") == 0 && i + 1 < argc) {
+      app_name = argv[++i];
+    } else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+      seconds = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+      replay_path = argv[++i];
+    } else if (strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc) {
+      if (!telemetry_output_open(argv[++i])) {
+        fprintf(stderr, "can't open telemetry output: %s\n", argv[i]);
+        return 1;
+      }
+    } else {
+      fprintf(stderr,
+              "usage: %s [--app name] [--seconds n] [--replay log] "
+              "[--telemetry file]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+  if (seconds == 0 && replay_path == NULL)
+    seconds = 60;
+  run.end_us = (uint64_t)(seconds * 1e6);
+
+  audio_stats_init(&g_audio_stats, AUDIO_SAMPLE_RATE, AUDIO_BUFFER_SIZE);
+  engine_init();
+
+  if (replay_path != NULL) {
+    if (!input_log_load(&input_log, replay_path)) {
+      fprintf(stderr, "can't load input log: %s\n", replay_path);
+      return 1;
+    }
+    app_t *app = find_app(app_name != NULL ? app_name : input_log.app);
+    engine_replay_start(&input_log, app);
+    run.replay = seconds == 0;
+  } else if (app_name != NULL) {
+    engine_set_app(find_app(app_name));
+  }
+
+  run.wall_start_ns = wall_ns();
+  vclock_set_hook(on_clock);
+  engine_run_forever();
+  return 0;
+}
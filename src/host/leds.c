@@ -0,0 +1,13 @@
+#include <shared/leds.h>
+
+// no LEDs on host, colors are only kept in leds_t
+
+void leds_init(leds_t *leds) { leds_set_all(leds, (color_t){.hex = 0}); }
+
+void leds_show(leds_t *leds) {}
+
+void leds_set_all(leds_t *leds, color_t color) {
+  for (int i = 0; i < LED_COUNT; i++) {
+    leds->colors[i] = color;
+  }
+}
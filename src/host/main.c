@@ -5,8 +5,13 @@
 #include <SDL.h>
 #include <u8g2.h>
 
+#include <shared/audio/midi.h>
+#include <shared/audio/stats.h>
 #include <shared/audio/synth.h>
 #include <shared/config.h>
+#include <shared/engine.h>
+#include <shared/input.h>
+#include <shared/midi_input.h>
 #include <shared/utils/timing.h>
 
 #include "audio.h"
@@ -14,15 +19,34 @@
 
 display_t display;
 audio_synth_t synth;
+audio_synth_midi_t midi;
+static const char *midi_source = NULL;
 
 void *audio_thread_main() {
-  audio_init();
+  // play the demo loop unless notes come from MIDI
+  audio_init(&synth, midi_source == NULL);
   // todo: event handling, timeline controller
 
   return NULL;
 }
 
-// todo: buttons
+static button_id_t button_from_key(SDL_Keycode key) {
+  switch (key) {
+  case SDLK_LEFT:
+  case SDLK_a:
+    return BUTTON_LEFT;
+  case SDLK_RIGHT:
+  case SDLK_d:
+    return BUTTON_RIGHT;
+  case SDLK_SPACE:
+  case SDLK_m:
+  case SDLK_ESCAPE:
+    return BUTTON_MENU;
+  default:
+    return BUTTON_NONE;
+  }
+}
+
 static void inline handle_sdl_events() {
   static SDL_Event event;
   while (SDL_PollEvent(&event)) {
@@ -30,18 +54,58 @@ static void inline handle_sdl_events() {
     case SDL_QUIT:
       exit(0);
       break;
+    case SDL_KEYDOWN:
+    case SDL_KEYUP: {
+      // keys stand in for the buttons. auto-repeat isn't a button edge
+      button_id_t button = button_from_key(event.key.keysym.sym);
+      if (button == BUTTON_NONE || event.key.repeat)
+        break;
+      input_push(&g_input,
+                 &(input_event_t){.time = get_absolute_time(),
+                                  .button = button,
+                                  .pressed = event.type == SDL_KEYDOWN});
+      break;
+    }
     }
   }
 }
 
-int main() {
+// #define DEBUG_INPUT // print the button events
+
+// no engine on host yet to take the button events, keep the queue empty
+static void drain_input() {
+  input_event_t event;
+  while (input_peek(&g_input, &event)) {
+    input_pop(&g_input);
+#ifdef DEBUG_INPUT
+    printf("button %d %s at %llu us\n", event.button,
+           event.pressed ? "down" : "up",
+           (unsigned long long)to_us_since_boot(event.time));
+#endif
+  }
+}
+
+// usage: mck-parting-c [midi source]
+// the MIDI source is a raw MIDI stream, a standard MIDI file or a named pipe
+// carrying either ("-" for stdin).
+int main(int argc, char **argv) {
+  if (argc > 1)
+    midi_source = argv[1];
+
+  audio_synth_init(&synth, AUDIO_SAMPLE_RATE, 1000);
+  synth.master_level = q1x15_f(0.5f);
+  audio_synth_midi_init(&midi, &synth, 0, AUDIO_SYNTH_VOICE_COUNT);
+  midi_input_init(&midi, midi_source);
+
   pthread_t audio_thread;
   pthread_create(&audio_thread, NULL, audio_thread_main, NULL);
 
   display_init(&display);
 
-  TimingInstrumenter ti_tick;
-  TimingInstrumenter ti_show;
+  TimingInstrumenter ti_tick = {0};
+  TimingInstrumenter ti_show = {0};
+  ti_init(&ti_tick);
+  ti_init(&ti_show);
 
   uint64_t last_frame_us = 0;
   uint64_t last_log_us = 0;
@@ -53,6 +117,7 @@ int main() {
   u8g2_t *u8g2 = display_get_u8g2(&display);
   while (1) {
     handle_sdl_events();
+    drain_input();
     ti_start(&ti_tick);
     i = (i + 1) % DISP_PIX;
     uint8_t x = i % DISP_WIDTH;
@@ -80,8 +145,14 @@ int main() {
       float ti_tick_avg = ti_get_average_ms(&ti_tick, true);
       float ti_show_avg = ti_get_average_ms(&ti_show, true);
       float ti_frame_avg = ti_tick_avg + ti_show_avg;
-      printf("fps: %d | frame: %.2f ms | tick: %.2f ms | show: %.2f ms\n", fps,
-             ti_frame_avg, ti_tick_avg, ti_show_avg);
+      audio_stats_snapshot_t synth;
+      audio_stats_read(&g_audio_stats, &synth);
+      printf("fps: %d | frame: %.2f ms | tick: %.2f ms | show: %.2f ms | "
+             "synth: %d%% (p99 %d%%, peak %d%%) | xrun: %d / %d | "
+             "midi: %d notes, %d us (peak %d us), %d dropped\n",
+             fps, ti_frame_avg, ti_tick_avg, ti_show_avg, synth.avg_load,
+             synth.p99_load, synth.peak_load, synth.overruns, synth.underruns,
+             synth.notes, synth.note_avg_us, synth.note_peak_us, midi.dropped);
       last_log_us = now;
       last_log_frames = 0;
     }
@@ -0,0 +1,15 @@
+#include <shared/memory.h>
+
+// host stacks and heap grow as needed, nothing to report
+
+void memory_paint_stack() {}
+
+uint32_t memory_stack_peak(uint8_t core, uint32_t *size) {
+  *size = 0;
+  return 0;
+}
+
+uint32_t memory_heap_used(uint32_t *peak) {
+  *peak = 0;
+  return 0;
+}
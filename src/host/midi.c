@@ -0,0 +1,238 @@
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <pico/time.h>
+
+#include <shared/midi_input.h>
+
+static audio_synth_midi_t *input_midi;
+static const char *input_source;
+
+//// STANDARD MIDI FILE REPLAY ////
+
+typedef struct {
+  const uint8_t *pos;
+  const uint8_t *end;
+  uint32_t tick;  // absolute tick of the next event
+  uint8_t status; // running status
+  bool done;
+} smf_track_t;
+
+static uint32_t read_be(const uint8_t *p, int n) {
+  uint32_t value = 0;
+  while (n--)
+    value = (value << 8) | *p++;
+  return value;
+}
+
+static bool read_varlen(smf_track_t *track, uint32_t *out) {
+  uint32_t value = 0;
+  for (int i = 0; i < 4 && track->pos < track->end; i++) {
+    uint8_t byte = *track->pos++;
+    value = (value << 7) | (byte & 0x7f);
+    if (!(byte & 0x80)) {
+      *out = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+static void track_next_delta(smf_track_t *track) {
+  uint32_t delta;
+  if (read_varlen(track, &delta))
+    track->tick += delta;
+  else
+    track->done = true;
+}
+
+// run the next event of a track. returns true and fills `msg` for channel
+// messages, updates `tempo` for tempo meta events.
+static bool track_event(smf_track_t *track, midi_message_t *msg,
+                        uint32_t *tempo) {
+  if (track->pos >= track->end) {
+    track->done = true;
+    return false;
+  }
+  uint8_t status = *track->pos;
+  if (status & 0x80)
+    track->pos++;
+  else
+    status = track->status;
+
+  uint32_t len;
+  if (status == 0xff) {
+    uint8_t type = track->pos < track->end ? *track->pos++ : 0x2f;
+    if (!read_varlen(track, &len)) {
+      track->done = true;
+      return false;
+    }
+    if (type == 0x51 && len == 3 && track->pos + 3 <= track->end)
+      *tempo = read_be(track->pos, 3);
+    if (type == 0x2f)
+      track->done = true;
+    track->pos += len;
+    return false;
+  }
+  if (status == MIDI_SYSEX || status == MIDI_SYSEX_END) {
+    if (read_varlen(track, &len))
+      track->pos += len;
+    else
+      track->done = true;
+    return false;
+  }
+  if (!(status & 0x80)) {
+    track->done = true; // data without running status, corrupt track
+    return false;
+  }
+
+  uint8_t kind = status & 0xf0;
+  len = kind == MIDI_PROGRAM_CHANGE || kind == MIDI_CHANNEL_PRESSURE ? 1 : 2;
+  if (track->pos + len > track->end) {
+    track->done = true;
+    return false;
+  }
+  track->status = status;
+  msg->status = status;
+  msg->data[0] = track->pos[0];
+  msg->data[1] = len > 1 ? track->pos[1] : 0;
+  track->pos += len;
+  return true;
+}
+
+// ticks per quarter note, or smpte frames per second (negated, high byte) and
+// ticks per frame. a zero in any of them would divide by zero when timing
+static bool division_valid(uint16_t division) {
+  if (division & 0x8000)
+    return (division & 0x7f00) != 0 && (division & 0xff) != 0;
+  return division != 0;
+}
+
+static void smf_play(const uint8_t *data, size_t size) {
+  if (size < 14 || read_be(data + 4, 4) < 6 ||
+      !division_valid(read_be(data + 12, 2))) {
+    printf("midi: bad file header\n");
+    return;
+  }
+  uint16_t track_count = read_be(data + 10, 2);
+  uint16_t division = read_be(data + 12, 2);
+
+  smf_track_t *tracks = calloc(track_count, sizeof(smf_track_t));
+  const uint8_t *pos = data + 8 + read_be(data + 4, 4);
+  const uint8_t *end = data + size;
+  uint16_t found = 0;
+  while (found < track_count && pos + 8 <= end) {
+    uint32_t len = read_be(pos + 4, 4);
+    const uint8_t *chunk = pos + 8;
+    pos = chunk + len > end ? end : chunk + len;
+    if (memcmp(chunk - 8, "MTrk", 4) != 0)
+      continue;
+    tracks[found].pos = chunk;
+    tracks[found].end = pos;
+    track_next_delta(&tracks[found]);
+    found++;
+  }
+
+  uint32_t tempo = 500000; // us per quarter note
+  uint64_t elapsed_us = 0;
+  uint32_t last_tick = 0;
+  uint32_t messages = 0;
+  absolute_time_t start = get_absolute_time();
+  while (true) {
+    // merge tracks in tick order
+    smf_track_t *next = NULL;
+    for (uint16_t i = 0; i < found; i++)
+      if (!tracks[i].done && (!next || tracks[i].tick < next->tick))
+        next = &tracks[i];
+    if (!next)
+      break;
+
+    uint32_t ticks = next->tick - last_tick;
+    last_tick = next->tick;
+    if (division & 0x8000) {
+      // smpte: frames per second * ticks per frame
+      uint32_t fps = (uint32_t)(-(int8_t)(division >> 8));
+      elapsed_us += (uint64_t)ticks * 1000000 / (fps * (division & 0xff));
+    } else {
+      elapsed_us += (uint64_t)ticks * tempo / division;
+    }
+
+    midi_message_t msg;
+    if (track_event(next, &msg, &tempo)) {
+      sleep_until(delayed_by_us(start, elapsed_us));
+      audio_synth_midi_message(input_midi, &msg, time_us_32());
+      messages++;
+    }
+    if (!next->done)
+      track_next_delta(next);
+  }
+  free(tracks);
+  printf("midi: file done, %u messages, %u dropped\n", messages,
+         input_midi->dropped);
+}
+
+//// RAW STREAM ////
+
+static int open_source() {
+  if (strcmp(input_source, "-") == 0)
+    return STDIN_FILENO;
+  int fd = open(input_source, O_RDONLY);
+  if (fd < 0)
+    perror("midi: open");
+  return fd;
+}
+
+static void *midi_thread_main(void *arg) {
+  (void)arg;
+  uint8_t buf[256];
+  while (true) {
+    int fd = open_source();
+    if (fd < 0)
+      return NULL;
+    struct stat st;
+    bool fifo = fstat(fd, &st) == 0 && S_ISFIFO(st.st_mode);
+
+    ssize_t len = read(fd, buf, 4);
+    if (len == 4 && memcmp(buf, "MThd", 4) == 0) {
+      // standard MIDI file, load it fully and replay in real time
+      size_t size = 4, cap = 4096;
+      uint8_t *data = malloc(cap);
+      memcpy(data, buf, 4);
+      while ((len = read(fd, data + size, cap - size)) > 0) {
+        size += len;
+        if (size == cap)
+          data = realloc(data, cap *= 2);
+      }
+      smf_play(data, size);
+      free(data);
+    } else {
+      // raw byte stream, fed as it arrives
+      while (len > 0) {
+        audio_synth_midi_feed(input_midi, buf, len, time_us_32());
+        len = read(fd, buf, sizeof(buf));
+      }
+    }
+
+    if (fd != STDIN_FILENO)
+      close(fd);
+    if (!fifo)
+      return NULL;
+    // pipe writer went away, wait for the next one
+  }
+}
+
+void midi_input_init(audio_synth_midi_t *midi, const char *source) {
+  if (source == NULL)
+    return;
+  input_midi = midi;
+  input_source = source;
+
+  pthread_t thread;
+  pthread_create(&thread, NULL, midi_thread_main, NULL);
+  pthread_detach(thread);
+}
@@ -0,0 +1,18 @@
+#include <stdio.h>
+
+#include <shared/telemetry.h>
+
+static FILE *output;
+
+bool telemetry_output_open(const char *path) {
+  output = fopen(path, "wb");
+  return output != NULL;
+}
+
+size_t telemetry_output_write(const uint8_t *data, size_t len) {
+  if (output != NULL) {
+    fwrite(data, 1, len, output);
+    fflush(output);
+  }
+  return len;
+}
@@ -0,0 +1,42 @@
+// pico/time.h is left out on purpose: these definitions take the place of the
+// SDK's weak host implementations, and some of them are inline in its headers.
+// absolute_time_t is a plain uint64_t of microseconds on host.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vclock.h"
+
+static uint64_t now_us;
+static vclock_hook_t clock_hook;
+
+void vclock_set_hook(vclock_hook_t hook) { clock_hook = hook; }
+
+static void advance_to(uint64_t t) {
+  if (t <= now_us)
+    return;
+  now_us = t;
+  if (clock_hook != NULL)
+    clock_hook(now_us);
+}
+
+uint64_t time_us_64(void) { return now_us; }
+
+uint32_t time_us_32(void) { return (uint32_t)now_us; }
+
+bool time_reached(uint64_t t) { return now_us >= t; }
+
+void sleep_until(uint64_t t) { advance_to(t); }
+
+void sleep_us(uint64_t us) { advance_to(now_us + us); }
+
+void sleep_ms(uint32_t ms) { advance_to(now_us + (uint64_t)ms * 1000); }
+
+void busy_wait_until(uint64_t t) { advance_to(t); }
+
+void busy_wait_us(uint64_t us) { advance_to(now_us + us); }
+
+void busy_wait_us_32(uint32_t us) { advance_to(now_us + us); }
+
+void busy_wait_ms(uint32_t ms) { advance_to(now_us + (uint64_t)ms * 1000); }
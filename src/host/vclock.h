@@ -0,0 +1,13 @@
+// Virtual clock for headless runs.
+// Replaces the SDK's host time functions, so time only moves when the program
+// sleeps or busy-waits, and sleeping returns immediately. A minute of engine
+// time then runs as fast as the CPU allows, and identically every run.
+
+#pragma once
+
+#include <stdint.h>
+
+// called every time the clock moves, with the new time
+typedef void (*vclock_hook_t)(uint64_t now_us);
+
+void vclock_set_hook(vclock_hook_t hook);
@@ -2,10 +2,12 @@
 
 #include <hardware/dma.h>
 #include <hardware/pio.h>
+#include <pico/time.h>
 
 #include <shared/audio/buffer.h>
+#include <shared/audio/stats.h>
 #include <shared/audio/synth.h>
-#include <shared/utils/timing.h>
+#include <shared/trace.h>
 
 #include "audio.h"
 #include "audio.pio.h"
@@ -25,6 +27,7 @@ static const uint32_t SM_CLKDIV_FRAC = (SYS_CLOCK_HZ % SM_BCLK) * 256 / SM_BCLK;
 // Shared state
 static const uint32_t SILENT_BUFFER[AUDIO_BUFFER_SIZE] = {0};
 static audio_buffer_pool_t pool;
+static uint32_t pool_storage[AUDIO_BUFFER_POOL_SIZE * AUDIO_BUFFER_SIZE];
 static int dma_channel;
 
 // initialize pio state machine for i2s
@@ -54,8 +57,10 @@ static void audio_playback_write_pio_init(PIO pio, uint8_t sm) {
 static void __isr audio_playback_write_dma_irq_handler(void) {
   // clear the interrupt
   dma_hw->ints0 = 1u << dma_channel;
+  trace_instant(TRACE_AUDIO_DMA_IRQ, pool.count);
 
   static bool using_pool_buffer = false;
+  static bool primed = false; // don't count silence before the first buffer
 
   if (using_pool_buffer) {
     // return borrowed buffer to pool
@@ -67,9 +72,12 @@ static void __isr audio_playback_write_dma_irq_handler(void) {
     // no buffer available, use silent buffer
     dma_channel_set_read_addr(dma_channel, SILENT_BUFFER, true);
     using_pool_buffer = false;
+    if (primed)
+      audio_stats_underrun(&g_audio_stats);
   } else {
     dma_channel_set_read_addr(dma_channel, next_buffer, true);
     using_pool_buffer = true;
+    primed = true;
   }
 }
 
@@ -105,7 +113,9 @@ void audio_playback_init() {
   gpio_set_dir(AUDIO_I2S_EN, GPIO_OUT);
   audio_playback_set_enabled(true);
 
-  audio_buffer_pool_init(&pool, AUDIO_BUFFER_POOL_SIZE, AUDIO_BUFFER_SIZE);
+  audio_buffer_pool_init(&pool, pool_storage, AUDIO_BUFFER_POOL_SIZE,
+                         AUDIO_BUFFER_SIZE);
+  audio_stats_init(&g_audio_stats, AUDIO_SAMPLE_RATE, AUDIO_BUFFER_SIZE);
 
   uint8_t sm = pio_claim_unused_sm(AUDIO_I2S_PIO, true);
 
@@ -116,24 +126,13 @@ void audio_playback_init() {
 void audio_playback_run_forever(audio_synth_t *synth) {
   // todo: pause and resume when sleep, no audio, etc. good power saving to be
   // had.
-  TimingInstrumenter ti_synth;
-
-  int i = 0;
-  int buf_per_sec = AUDIO_SAMPLE_RATE / AUDIO_BUFFER_SIZE;
-  float ms_per_buf = 1000.0f / (float)buf_per_sec;
   while (true) {
     audio_buffer_t buffer = audio_buffer_pool_acquire_write(&pool, true);
-    ti_start(&ti_synth);
+    uint32_t start_us = time_us_32();
+    trace_begin(TRACE_SYNTH_BUFFER);
     audio_synth_fill_buffer(synth, buffer, pool.buffer_size);
-    ti_stop(&ti_synth);
+    trace_end(TRACE_SYNTH_BUFFER);
+    audio_stats_record(&g_audio_stats, time_us_32() - start_us);
     audio_buffer_pool_commit_write(&pool);
-
-    if (i > buf_per_sec) {
-      i = 0;
-      // printf("synth: %.2f ms / %.2f ms\n", ti_get_average_ms(&ti_synth,
-      // true),
-      //        ms_per_buf);
-    }
-    i++;
   }
 }
@@ -11,6 +11,8 @@
 #define BUTTON_PIN_L 10
 #define BUTTON_PIN_R 11
 #define BUTTON_PIN_M 12
+// edges within this window after a transition are treated as contact bounce
+#define BUTTON_DEBOUNCE_US 5000
 
 //// DISPLAY CONFIGURATION ////
 #define DISP_SPI_PORT spi0
@@ -32,7 +34,12 @@
 #define AUDIO_BUFFER_SIZE 128
 #define AUDIO_BUFFER_POOL_SIZE 2
 
-// todo: compute some form of audio budget and warn if exceeded
+// render budget per buffer is AUDIO_BUFFER_SIZE / AUDIO_SAMPLE_RATE (2.67 ms).
+// core1 tracks load against it, see shared/audio/stats.h
+
+//// MIDI CONFIGURATION ////
+// treat bytes received on USB stdio as MIDI input to the synth
+#define MIDI_INPUT_USB_STDIO 1
 
 //// PERIPHERAL CONFIGURATION ////
 #define PERIPH_PWR_EN 22
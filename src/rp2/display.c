@@ -4,6 +4,8 @@
 #include <u8g2.h>
 
 #include <shared/display.h>
+#include <shared/trace.h>
+#include <shared/utils/tile.h>
 
 #include "config.h"
 
@@ -22,6 +24,7 @@ static uint8_t _byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
     u8x8_gpio_SetDC(u8x8, arg_int);
     break;
   case U8X8_MSG_BYTE_START_TRANSFER:
+    trace_begin(TRACE_SPI_SEND);
     u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_enable_level);
     u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO,
                             u8x8->display_info->post_chip_enable_wait_ns, NULL);
@@ -30,6 +33,7 @@ static uint8_t _byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
     u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO,
                             u8x8->display_info->pre_chip_disable_wait_ns, NULL);
     u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+    trace_end(TRACE_SPI_SEND);
     break;
   default:
     return 0;
@@ -84,11 +88,55 @@ static uint8_t _gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
   return 1;
 }
 
+// the panel is a 64x128 SH1107 mounted sideways. u8g2 draws into a plain
+// 128x64 buffer (R0) and tiles are turned to the panel's orientation as they
+// are sent, instead of every pixel going through U8G2_R1.
+static u8x8_display_info_t _display_info;
+
+static uint8_t _display_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
+                           void *arg_ptr) {
+  switch (msg) {
+  case U8X8_MSG_DISPLAY_SETUP_MEMORY:
+    u8x8_d_sh1107_64x128(u8x8, msg, arg_int, arg_ptr);
+    // the same panel, seen as 128x64
+    _display_info = *u8x8->display_info;
+    _display_info.tile_width = DISP_WIDTH / 8;
+    _display_info.tile_height = DISP_HEIGHT / 8;
+    _display_info.pixel_width = DISP_WIDTH;
+    _display_info.pixel_height = DISP_HEIGHT;
+    u8x8->display_info = &_display_info;
+    return 1;
+  case U8X8_MSG_DISPLAY_DRAW_TILE: {
+    // a buffer tile column is a panel page, a buffer tile row a panel tile
+    // column counted from the right
+    const u8x8_tile_t *tiles = (const u8x8_tile_t *)arg_ptr;
+    uint8_t rotated[8];
+    u8x8_tile_t tile = {.tile_ptr = rotated, .cnt = 1};
+    tile.x_pos = DISP_HEIGHT / 8 - 1 - tiles->y_pos;
+    for (uint8_t rep = 0; rep < arg_int; rep++) {
+      for (uint8_t i = 0; i < tiles->cnt; i++) {
+        tile_rotate_r1(tiles->tile_ptr + i * 8, rotated);
+        tile.y_pos = tiles->x_pos + rep * tiles->cnt + i;
+        u8x8_d_sh1107_64x128(u8x8, msg, 1, &tile);
+      }
+    }
+    return 1;
+  }
+  default:
+    return u8x8_d_sh1107_64x128(u8x8, msg, arg_int, arg_ptr);
+  }
+}
+
 void display_init(display_t *display) {
   display->enabled = false;
 
   u8g2_t *u8g2 = display_get_u8g2(display);
-  u8g2_Setup_sh1107_64x128_f(u8g2, U8G2_R1, _byte_cb, _gpio_and_delay_cb);
+  u8g2_SetupDisplay(u8g2, _display_cb, u8x8_cad_001, _byte_cb,
+                    _gpio_and_delay_cb);
+  uint8_t tile_buf_height;
+  uint8_t *buf = u8g2_m_16_8_f(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_vertical_top_lsb,
+                   U8G2_R0);
   u8g2_InitDisplay(u8g2);
 
   gpio_init(DISP_REG_EN);
@@ -104,6 +152,7 @@ static void display_on(display_t *display) {
   u8g2_t *u8g2 = display_get_u8g2(display);
   u8g2_ClearBuffer(u8g2);
   u8g2_SendBuffer(u8g2);
+  display_invalidate(display); // panel RAM was lost while powered down
   u8g2_SetPowerSave(u8g2, 0);
   u8g2_SetContrast(u8g2, 255);
 }
@@ -23,46 +23,102 @@
 #include <pico/stdlib.h>
 
 #include <shared/engine.h>
+#include <shared/input.h>
+#include <shared/memory.h>
 #include <shared/utils/timing.h>
 
 #include "audio.h"
 #include "config.h"
 
 void core1_main() {
+  memory_paint_stack();
   audio_playback_init();
   audio_playback_run_forever(&g_engine.synth);
 }
 
 void core0_main() { engine_run_forever(); }
 
-void engine_buttons_init() {
-  gpio_init(BUTTON_PIN_L);
-  gpio_set_dir(BUTTON_PIN_L, GPIO_IN);
-  gpio_pull_up(BUTTON_PIN_L);
+// buttons are read from GPIO edge interrupts. the first edge of a transition
+// is timestamped and queued right away, further edges are ignored for
+// BUTTON_DEBOUNCE_US. when that runs out the level is checked again, which
+// catches a transition that happened while bouncing.
+typedef struct {
+  uint gpio;
+  button_id_t id;
+  bool pressed;            // debounced level
+  bool settling;           // within the debounce window
+  absolute_time_t edge_at; // last raw edge while settling
+} button_pin_t;
+
+static button_pin_t button_pins[] = {
+    {.gpio = BUTTON_PIN_L, .id = BUTTON_LEFT},
+    {.gpio = BUTTON_PIN_R, .id = BUTTON_RIGHT},
+    {.gpio = BUTTON_PIN_M, .id = BUTTON_MENU},
+};
+#define BUTTON_PIN_COUNT (sizeof(button_pins) / sizeof(button_pins[0]))
+
+static inline bool button_pin_level(const button_pin_t *pin) {
+  return !gpio_get(pin->gpio); // active low
+}
 
-  gpio_init(BUTTON_PIN_R);
-  gpio_set_dir(BUTTON_PIN_R, GPIO_IN);
-  gpio_pull_up(BUTTON_PIN_R);
+static int64_t button_settle_callback(alarm_id_t id, void *user_data) {
+  button_pin_t *pin = user_data;
+  bool level = button_pin_level(pin);
+  if (level == pin->pressed) {
+    pin->settling = false;
+    return 0;
+  }
+  pin->pressed = level;
+  input_push(&g_input, &(input_event_t){.time = pin->edge_at,
+                                        .button = pin->id,
+                                        .pressed = level});
+  return BUTTON_DEBOUNCE_US; // new transition, settle again
+}
 
-  gpio_init(BUTTON_PIN_M);
-  gpio_set_dir(BUTTON_PIN_M, GPIO_IN);
-  gpio_pull_up(BUTTON_PIN_M);
+static void button_irq_callback(uint gpio, uint32_t events) {
+  absolute_time_t now = get_absolute_time();
+  for (uint i = 0; i < BUTTON_PIN_COUNT; i++) {
+    button_pin_t *pin = &button_pins[i];
+    if (pin->gpio != gpio)
+      continue;
+    pin->edge_at = now;
+    if (pin->settling)
+      return;
+    bool level = button_pin_level(pin);
+    if (level == pin->pressed)
+      return;
+    pin->pressed = level;
+    pin->settling = true;
+    input_push(&g_input, &(input_event_t){.time = now,
+                                          .button = pin->id,
+                                          .pressed = level});
+    // no free alarm: skip the debounce rather than settle forever
+    if (add_alarm_in_us(BUTTON_DEBOUNCE_US, button_settle_callback, pin,
+                        true) < 0)
+      pin->settling = false;
+    return;
+  }
+}
+
+void engine_buttons_init() {
+  for (uint i = 0; i < BUTTON_PIN_COUNT; i++) {
+    button_pin_t *pin = &button_pins[i];
+    gpio_init(pin->gpio);
+    gpio_set_dir(pin->gpio, GPIO_IN);
+    gpio_pull_up(pin->gpio);
+    pin->pressed = button_pin_level(pin);
+    gpio_set_irq_enabled_with_callback(
+        pin->gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true,
+        button_irq_callback);
+  }
 }
 
 bool engine_button_read(button_id_t button_id) {
-  uint gpio;
-  switch (button_id) {
-  case BUTTON_LEFT:
-    gpio = BUTTON_PIN_L;
-    break;
-  case BUTTON_RIGHT:
-    gpio = BUTTON_PIN_R;
-    break;
-  case BUTTON_MENU:
-    gpio = BUTTON_PIN_M;
-    break;
+  for (uint i = 0; i < BUTTON_PIN_COUNT; i++) {
+    if (button_pins[i].id == button_id)
+      return button_pin_level(&button_pins[i]);
   }
-  return 1 - gpio_get(gpio); // active low
+  return false;
 }
 
 void measure_freqs(void) {
@@ -188,6 +244,7 @@ void engine_sleep_until_interrupt() {
 }
 
 int main() {
+  memory_paint_stack();
   // hack to limit power draw until after usb stack is initialized
   // since macos doesn't like it when the usb device draws too much power
   // immediately.
@@ -0,0 +1,48 @@
+#include <malloc.h>
+
+#include <pico/platform.h>
+
+#include <shared/memory.h>
+
+// from the SDK linker script: core0 runs on the scratch Y stack, core1 on
+// the scratch X one multicore_launch_core1() uses
+extern uint32_t __StackBottom, __StackTop;
+extern uint32_t __StackOneBottom, __StackOneTop;
+
+// keep clear of the caller's frame
+#define PAINT_MARGIN 64
+
+static void stack_bounds(uint8_t core, uint32_t **bottom, uint32_t **top) {
+  if (core == 0) {
+    *bottom = &__StackBottom;
+    *top = &__StackTop;
+  } else {
+    *bottom = &__StackOneBottom;
+    *top = &__StackOneTop;
+  }
+}
+
+void memory_paint_stack() {
+  uint32_t *bottom, *top;
+  stack_bounds(get_core_num(), &bottom, &top);
+  volatile uint32_t here; // roughly the stack pointer
+  uint32_t *sp = (uint32_t *)&here;
+  for (uint32_t *p = bottom; p < sp - PAINT_MARGIN / 4; p++)
+    *p = MEMORY_STACK_PATTERN;
+}
+
+uint32_t memory_stack_peak(uint8_t core, uint32_t *size) {
+  uint32_t *bottom, *top;
+  stack_bounds(core, &bottom, &top);
+  uint32_t *p = bottom;
+  while (p < top && *p == MEMORY_STACK_PATTERN)
+    p++;
+  *size = (top - bottom) * sizeof(uint32_t);
+  return (top - p) * sizeof(uint32_t);
+}
+
+uint32_t memory_heap_used(uint32_t *peak) {
+  struct mallinfo info = mallinfo();
+  *peak = info.arena; // newlib never gives heap back
+  return info.uordblks;
+}
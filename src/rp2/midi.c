@@ -0,0 +1,42 @@
+#include <pico/stdio.h>
+#include <pico/time.h>
+
+#include <shared/midi_input.h>
+
+#include "config.h"
+
+#if MIDI_INPUT_USB_STDIO
+
+static audio_synth_midi_t *input_midi;
+
+// called from the USB IRQ whenever stdio has received data
+static void chars_available(void *param) {
+  (void)param;
+  uint8_t bytes[32];
+  size_t len = 0;
+  uint32_t time_us = time_us_32();
+  int c;
+  while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+    bytes[len++] = (uint8_t)c;
+    if (len == sizeof(bytes)) {
+      audio_synth_midi_feed(input_midi, bytes, len, time_us);
+      len = 0;
+    }
+  }
+  audio_synth_midi_feed(input_midi, bytes, len, time_us);
+}
+
+void midi_input_init(audio_synth_midi_t *midi, const char *source) {
+  (void)source;
+  input_midi = midi;
+  stdio_set_chars_available_callback(chars_available, NULL);
+}
+
+#else
+
+void midi_input_init(audio_synth_midi_t *midi, const char *source) {
+  (void)midi;
+  (void)source;
+}
+
+#endif
@@ -0,0 +1,17 @@
+#include <pico/stdio_usb.h>
+#include <tusb.h>
+
+#include <shared/telemetry.h>
+
+// write straight to the USB stdio driver: no CR/LF translation, and never more
+// than the CDC FIFO has room for, so it can't block the frame loop
+size_t telemetry_output_write(const uint8_t *data, size_t len) {
+  if (!stdio_usb_connected())
+    return len; // nobody listening
+  uint32_t space = tud_cdc_write_available();
+  if (len > space)
+    len = space;
+  if (len > 0)
+    stdio_usb.out_chars((const char *)data, (int)len);
+  return len;
+}
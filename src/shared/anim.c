@@ -1,175 +1,525 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "anim.h"
 
 anim_sys_t g_anim;
 
-static inline uint32_t anim_ease_linear(uint32_t p_q16) { return p_q16; }
-
-// InOut quad: 2p^2 (p<0.5) else 1 - 2(1-p)^2
-static inline uint32_t anim_ease_inout_quad(uint32_t p_q16) {
-  // p in [0, 65536]
-  if (p_q16 <= 32768u) {
-    // 2 * p^2
-    // (p*p)>>16 fits in 32 bits if we cast to 64 during mul
-    uint64_t pp = (uint64_t)p_q16 * (uint64_t)p_q16; // Q32.32
-    uint32_t p2 = (uint32_t)(pp >> 16);              // Q16.16
-    uint32_t r = p2 << 1;                            // *2
-    return r > 65536u ? 65536u : r;
-  } else {
-    // 1 - 2*(1-p)^2
-    uint32_t one = 65536u;
-    uint32_t pm = one - p_q16;
-    uint64_t pp = (uint64_t)pm * (uint64_t)pm; // Q32.32
-    uint32_t p2 = (uint32_t)(pp >> 16);        // Q16.16
-    uint32_t two_p2 = p2 << 1;
-    return (two_p2 >= one) ? 0u : (one - two_p2);
-  }
-}
-
-static inline uint32_t anim_ease_out_cubic(uint32_t p_q16) {
-  // p_q16 is in [0, 65536]
-  uint32_t one = 65536u;
-  uint32_t inv = one - p_q16; // (1 - t)
-
-  // inv^3 in Q16.16: (inv * inv * inv) >> 32
-  uint64_t inv2 = (uint64_t)inv * inv;        // Q32.32
-  uint64_t inv3 = (inv2 >> 16) * inv;         // (Q16.16 * Q16.16) -> Q32.32
-  uint32_t inv3_q16 = (uint32_t)(inv3 >> 16); // back to Q16.16
-
-  return one - inv3_q16;
-}
-
-static inline uint32_t anim_apply_ease(anim_ease_t e, uint32_t p_q16) {
-  switch (e) {
-  case ANIM_EASE_INOUT_QUAD:
-    return anim_ease_inout_quad(p_q16);
-  case ANIM_EASE_LINEAR:
-    return anim_ease_linear(p_q16);
-  case ANIM_EASE_OUT_CUBIC:
-    return anim_ease_out_cubic(p_q16);
+static inline uint32_t bucket_of(volatile void *out) {
+  return ((uint32_t)(uintptr_t)out * 2654435761u >> 16) & (ANIM_BUCKETS - 1);
+}
+
+static inline anim_handle_t handle_of(uint32_t idx) {
+  return ((uint32_t)g_anim.slots[idx].generation << 16) | (idx + 1);
+}
+
+static int find_slot_by_ptr(volatile void *ptr) {
+  for (uint32_t n = g_anim.buckets[bucket_of(ptr)]; n != 0;
+       n = g_anim.slots[n - 1].next)
+    if (g_anim.slots[n - 1].target == ptr)
+      return n - 1;
+  return -1;
+}
+
+static int find_slot_by_handle(anim_handle_t handle) {
+  uint32_t idx = (handle & 0xffff) - 1;
+  if (handle == ANIM_NONE || idx >= g_anim.used)
+    return -1;
+  anim_slot_t *s = &g_anim.slots[idx];
+  if (!s->active || s->generation != handle >> 16)
+    return -1;
+  return idx;
+}
+
+// take a free slot and add it to the active list and its bucket
+static int acquire_slot(volatile void *out, anim_channel_t channel) {
+  uint32_t idx;
+  if (g_anim.free_count > 0)
+    idx = g_anim.free[--g_anim.free_count];
+  else if (g_anim.used < ANIM_MAX)
+    idx = g_anim.used++;
+  else
+    return -1;
+
+  anim_slot_t *s = &g_anim.slots[idx];
+  s->target = out;
+  s->channel = channel;
+  s->active = 1;
+  s->active_at = g_anim.active_count;
+  g_anim.active[g_anim.active_count++] = idx;
+  uint16_t *bucket = &g_anim.buckets[bucket_of(out)];
+  s->next = *bucket;
+  *bucket = idx + 1;
+  return idx;
+}
+
+// stop a slot: unlink it and move the last active one into its place
+static void release_slot(uint32_t idx) {
+  anim_slot_t *s = &g_anim.slots[idx];
+  uint16_t *link = &g_anim.buckets[bucket_of(s->target)];
+  while (*link != idx + 1)
+    link = &g_anim.slots[*link - 1].next;
+  *link = s->next;
+
+  uint16_t last = g_anim.active[--g_anim.active_count];
+  g_anim.active[s->active_at] = last;
+  g_anim.slots[last].active_at = s->active_at;
+
+  s->active = 0;
+  s->generation++; // stale handles stop matching
+  g_anim.free[g_anim.free_count++] = idx;
+}
+
+void anim_init(void) { memset(&g_anim, 0, sizeof(g_anim)); }
+
+static anim_value_t load(volatile void *out, anim_channel_t channel) {
+  switch (channel) {
+  case ANIM_VEC2:
+    return (anim_value_t){.vec2 = *(volatile vec2_t *)out};
+  case ANIM_COLOR:
+    return (anim_value_t){.color.hex = ((volatile color_t *)out)->hex};
   default:
-    return anim_ease_linear(p_q16);
+    return (anim_value_t){.i = *(volatile int32_t *)out};
   }
 }
 
-static inline int find_slot_by_ptr(volatile int32_t *ptr) {
-  for (int i = 0; i < ANIM_MAX; ++i)
-    if (g_anim.slots[i].active && g_anim.slots[i].out == ptr)
-      return i;
-  return -1;
+static void store(volatile void *out, anim_channel_t channel,
+                  anim_value_t value) {
+  switch (channel) {
+  case ANIM_VEC2:
+    *(volatile vec2_t *)out = value.vec2;
+    break;
+  case ANIM_COLOR:
+    ((volatile color_t *)out)->hex = value.color.hex;
+    break;
+  default:
+    *(volatile int32_t *)out = value.i;
+    break;
+  }
 }
 
-static inline int find_free_slot(void) {
-  for (int i = 0; i < ANIM_MAX; ++i)
-    if (!g_anim.slots[i].active)
-      return i;
-  return -1;
+// blend two colors by w/256, two bytes per multiply: each 16-bit lane holds
+// at most 255 * 256, so lanes never carry into each other
+static inline uint32_t lerp_color(uint32_t a, uint32_t b, uint32_t w) {
+  uint32_t rb = ((a & 0x00ff00ffu) * (256 - w) + (b & 0x00ff00ffu) * w) >> 8;
+  uint32_t ga =
+      ((a >> 8 & 0x00ff00ffu) * (256 - w) + (b >> 8 & 0x00ff00ffu) * w) >> 8;
+  return (rb & 0x00ff00ffu) | (ga & 0x00ff00ffu) << 8;
+}
+
+static inline int16_t lerp_i16(int16_t a, int16_t b, int32_t e) {
+  return (int16_t)(a + (int32_t)(((int64_t)(b - a) * e) >> 16));
 }
 
-void anim_init(void) {
-  for (int i = 0; i < ANIM_MAX; ++i)
-    g_anim.slots[i].active = 0;
+// a tween's value at eased progress e (Q16.16)
+static anim_value_t tween_value(const anim_slot_t *s, int32_t e) {
+  switch (s->channel) {
+  case ANIM_VEC2:
+    return (anim_value_t){
+        .vec2 = vec2(lerp_i16(s->start.vec2.x, s->end.vec2.x, e),
+                     lerp_i16(s->start.vec2.y, s->end.vec2.y, e))};
+  case ANIM_COLOR: {
+    int32_t w = e < 0 ? 0 : e > 65536 ? 256 : (e + 128) >> 8;
+    return (anim_value_t){
+        .color.hex = lerp_color(s->start.color.hex, s->end.color.hex, w)};
+  }
+  default:
+    // start + (delta * e)>>16 (Q16.16 scale), up to ~48 bits
+    return (anim_value_t){
+        .i = s->start.i + (int32_t)(((int64_t)s->delta * e) >> 16)};
+  }
 }
 
 // Start/overwrite: animate *out from its current value to 'to' over
-// 'duration_ticks'
-static int _anim_to_impl(volatile int32_t *out, int32_t to,
-                         uint32_t duration_ticks, anim_ease_t ease,
-                         anim_done_fn on_done, void *ctx, bool is_sys) {
+// 'duration_ms'
+static anim_handle_t _anim_to_impl(volatile void *out, anim_channel_t channel,
+                                   anim_value_t to, uint32_t duration_ms,
+                                   ease_t ease, anim_done_fn on_done,
+                                   void *ctx, bool is_sys) {
   int idx = find_slot_by_ptr(out);
-  if (idx < 0)
-    idx = find_free_slot();
-  if (idx < 0) {
-    *out = to; // jump to end
-    return -1; // no capacity
+  if (idx >= 0 && duration_ms == 0u)
+    release_slot(idx); // finishes right away, no slot needed
+  else if (idx < 0 && duration_ms != 0u)
+    idx = acquire_slot(out, channel);
+
+  if (duration_ms == 0u || idx < 0) {
+    store(out, channel, to); // jump to end
+    if (duration_ms == 0u && on_done)
+      on_done(ctx);
+    return ANIM_NONE;
   }
 
   anim_slot_t *s = &g_anim.slots[idx];
-  s->out = out;
-  s->start = (int32_t)(*out);
+  s->channel = channel;
+  s->spring = false;
+  s->track = NULL;
+  s->group = 0;
+  s->start = load(out, channel);
   s->end = to;
-  s->delta = s->end - s->start;
-  s->ease = ease;
+  s->delta = channel == ANIM_INT ? to.i - s->start.i : 0;
+  s->curve = ease_get_table(ease);
   s->on_done = on_done;
   s->ctx = ctx;
   s->is_sys = is_sys;
+  s->elapsed_us = 0;
+  s->duration_us = duration_ms * 1000;
+  return handle_of(idx);
+}
 
-  if (duration_ticks == 0u) {
-    *s->out = s->end;
-    s->active = 0;
-    if (s->on_done)
-      s->on_done(s->ctx);
-    return idx;
-  }
+anim_handle_t anim_to(volatile int32_t *out, int32_t to,
+                      uint32_t duration_ms, ease_t ease,
+                      anim_done_fn on_done, void *ctx) {
+  return _anim_to_impl(out, ANIM_INT, (anim_value_t){.i = to}, duration_ms,
+                       ease, on_done, ctx, false);
+}
 
-  s->p_q16 = 0u;
-  s->dp_q16 = q16_from_ratio(1u, duration_ticks); // ≈ (1<<16)/duration
-  s->active = 1;
-  return idx;
+anim_handle_t anim_sys_to(volatile int32_t *out, int32_t to,
+                          uint32_t duration_ms, ease_t ease,
+                          anim_done_fn on_done, void *ctx) {
+  return _anim_to_impl(out, ANIM_INT, (anim_value_t){.i = to}, duration_ms,
+                       ease, on_done, ctx, true);
+}
+
+anim_handle_t anim_vec2_to(volatile vec2_t *out, vec2_t to,
+                           uint32_t duration_ms, ease_t ease,
+                           anim_done_fn on_done, void *ctx) {
+  return _anim_to_impl(out, ANIM_VEC2, (anim_value_t){.vec2 = to},
+                       duration_ms, ease, on_done, ctx, false);
+}
+
+anim_handle_t anim_sys_vec2_to(volatile vec2_t *out, vec2_t to,
+                               uint32_t duration_ms, ease_t ease,
+                               anim_done_fn on_done, void *ctx) {
+  return _anim_to_impl(out, ANIM_VEC2, (anim_value_t){.vec2 = to},
+                       duration_ms, ease, on_done, ctx, true);
 }
 
-int anim_to(volatile int32_t *out, int32_t to, uint32_t duration_ticks,
-            anim_ease_t ease, anim_done_fn on_done, void *ctx) {
-  return _anim_to_impl(out, to, duration_ticks, ease, on_done, ctx, false);
+anim_handle_t anim_color_to(volatile color_t *out, color_t to,
+                            uint32_t duration_ms, ease_t ease,
+                            anim_done_fn on_done, void *ctx) {
+  return _anim_to_impl(out, ANIM_COLOR, (anim_value_t){.color = to},
+                       duration_ms, ease, on_done, ctx, false);
 }
 
-int anim_sys_to(volatile int32_t *out, int32_t to, uint32_t duration_ticks,
-                anim_ease_t ease, anim_done_fn on_done, void *ctx) {
-  return _anim_to_impl(out, to, duration_ticks, ease, on_done, ctx, true);
+anim_handle_t anim_sys_color_to(volatile color_t *out, color_t to,
+                                uint32_t duration_ms, ease_t ease,
+                                anim_done_fn on_done, void *ctx) {
+  return _anim_to_impl(out, ANIM_COLOR, (anim_value_t){.color = to},
+                       duration_ms, ease, on_done, ctx, true);
 }
 
-void anim_cancel(volatile int32_t *out, int snap_to_end) {
+// critically damped springs: x'' = omega^2 (to - x) - 2 omega x'. omega is
+// picked so the distance is down to ~1% after settle_ms.
+#define SPRING_OMEGA_STEPS_Q24 111400714u // 6.64 in Q8.24
+// the fixed step integrator diverges for omega near 1, so springs settle in
+// no less than ~14 ms however short settle_ms is
+#define SPRING_OMEGA_MAX_Q24 (1 << 23) // 0.5
+
+// nearest integer of a spring position
+static inline int32_t spring_value(int32_t x_q16) {
+  return (x_q16 + (1 << 15)) >> 16;
+}
+
+static anim_handle_t _anim_spring_impl(volatile int32_t *out, int32_t to,
+                                       uint32_t settle_ms,
+                                       anim_done_fn on_done, void *ctx,
+                                       bool is_sys) {
   int idx = find_slot_by_ptr(out);
+  anim_slot_t *s = idx >= 0 ? &g_anim.slots[idx] : NULL;
+  // keep going if nobody moved *out since the last step
+  bool moving = s != NULL && s->spring && *out == spring_value(s->x_q16);
   if (idx < 0)
-    return;
-  anim_slot_t *s = &g_anim.slots[idx];
-  if (!s->active)
-    return;
-  if (snap_to_end)
-    *s->out = s->end;
-  s->active = 0;
+    idx = acquire_slot(out, ANIM_INT);
+  if (idx < 0) {
+    *out = to; // no capacity, jump to end
+    return ANIM_NONE;
+  }
+
+  s = &g_anim.slots[idx];
+  s->channel = ANIM_INT;
+  s->track = NULL;
+  s->group = 0;
+  if (!moving) {
+    // start from rest, or take over where a tween or the app left *out
+    s->x_q16 = *out * 65536;
+    s->v_q16 = 0;
+    s->rest_us = 0;
+  }
+  uint32_t settle_steps = settle_ms * 1000 / ANIM_SPRING_STEP_US;
+  int32_t omega = SPRING_OMEGA_MAX_Q24;
+  if (settle_steps > 0 && SPRING_OMEGA_STEPS_Q24 / settle_steps < omega)
+    omega = SPRING_OMEGA_STEPS_Q24 / settle_steps;
+  s->spring = true;
+  s->end.i = to;
+  s->k_q24 = ((int64_t)omega * omega) >> 24;
+  s->c_q24 = omega * 2;
+  s->on_done = on_done;
+  s->ctx = ctx;
+  s->is_sys = is_sys;
+  return handle_of(idx);
+}
+
+anim_handle_t anim_spring_to(volatile int32_t *out, int32_t to,
+                             uint32_t settle_ms, anim_done_fn on_done,
+                             void *ctx) {
+  return _anim_spring_impl(out, to, settle_ms, on_done, ctx, false);
+}
+
+anim_handle_t anim_sys_spring_to(volatile int32_t *out, int32_t to,
+                                 uint32_t settle_ms, anim_done_fn on_done,
+                                 void *ctx) {
+  return _anim_spring_impl(out, to, settle_ms, on_done, ctx, true);
+}
+
+// tween a slot from its current value to `to`
+static void start_segment(anim_slot_t *s, int32_t to, uint32_t duration_ms,
+                          ease_t ease) {
+  s->start.i = *s->out;
+  s->end.i = to;
+  s->delta = to - s->start.i;
+  s->curve = ease_get_table(ease);
+  s->elapsed_us = 0;
+  s->duration_us = duration_ms * 1000;
 }
 
-void anim_tick(void) {
-  for (int i = 0; i < ANIM_MAX; ++i) {
-    anim_slot_t *s = &g_anim.slots[i];
-    if (!s->active)
+// head for the next key of a timeline track, jumping through keys that take
+// no time. false once the track is over.
+static bool next_key(anim_slot_t *s, uint32_t key) {
+  const anim_track_t *track = s->track;
+  // a loop needs to take time, or it would never leave this function
+  bool loop = s->loop && track->keys[track->key_count - 1].at > 0;
+  while (true) {
+    if (key >= track->key_count) {
+      if (!loop)
+        return false;
+      key = 0;
+    }
+    const anim_key_t *k = &track->keys[key];
+    uint16_t from = key > 0 ? track->keys[key - 1].at : 0;
+    if (k->at > from) {
+      s->key = key;
+      start_segment(s, k->value, k->at - from, k->ease);
+      return true;
+    }
+    *s->out = s->end.i = k->value;
+    key++;
+  }
+}
+
+static anim_group_t _timeline_play_impl(const anim_timeline_t *timeline,
+                                        volatile int32_t *const *targets,
+                                        bool is_sys) {
+  if (++g_anim.last_group == 0)
+    g_anim.last_group = 1;
+  anim_group_t group = g_anim.last_group;
+
+  for (uint32_t i = 0; i < timeline->track_count; i++) {
+    const anim_track_t *track = &timeline->tracks[i];
+    volatile int32_t *out = targets[track->target];
+    if (track->key_count == 0)
       continue;
-    if (g_anim.paused && !s->is_sys)
-      // if paused, skip non-sys animations
+    int idx = find_slot_by_ptr(out);
+    if (idx < 0)
+      idx = acquire_slot(out, ANIM_INT);
+    if (idx < 0) {
+      *out = track->keys[track->key_count - 1].value; // no capacity
       continue;
+    }
+
+    anim_slot_t *s = &g_anim.slots[idx];
+    s->channel = ANIM_INT;
+    s->spring = false;
+    s->track = track;
+    s->group = group;
+    s->loop = timeline->loop;
+    s->on_done = NULL;
+    s->is_sys = is_sys;
+    if (track->delay > 0) {
+      // hold still, then head for key 0
+      s->key = UINT8_MAX;
+      start_segment(s, *out, track->delay, EASE_LINEAR);
+    } else if (!next_key(s, 0)) {
+      release_slot(idx);
+    }
+  }
+  return group;
+}
+
+anim_group_t anim_timeline_play(const anim_timeline_t *timeline,
+                                volatile int32_t *const *targets) {
+  return _timeline_play_impl(timeline, targets, false);
+}
+
+anim_group_t anim_sys_timeline_play(const anim_timeline_t *timeline,
+                                    volatile int32_t *const *targets) {
+  return _timeline_play_impl(timeline, targets, true);
+}
+
+static void cancel_slot(int idx, int snap_to_end) {
+  if (idx < 0)
+    return;
+  anim_slot_t *s = &g_anim.slots[idx];
+  if (snap_to_end && s->track != NULL)
+    *s->out = s->track->keys[s->track->key_count - 1].value;
+  else if (snap_to_end)
+    store(s->target, s->channel, s->end);
+  release_slot(idx);
+}
+
+void anim_cancel_group(anim_group_t group, int snap_to_end) {
+  for (uint32_t i = g_anim.active_count; i-- > 0;) {
+    uint32_t idx = g_anim.active[i];
+    if (group != 0 && g_anim.slots[idx].group == group)
+      cancel_slot(idx, snap_to_end);
+  }
+}
+
+bool anim_group_running(anim_group_t group) {
+  for (uint32_t i = 0; i < g_anim.active_count; i++)
+    if (group != 0 && g_anim.slots[g_anim.active[i]].group == group)
+      return true;
+  return false;
+}
 
-    uint32_t p = s->p_q16;
-    // advance progress
-    uint32_t p_next = p + s->dp_q16;
-    if (p_next >= 65536u)
-      p_next = 65536u;
-    s->p_q16 = p_next;
+void anim_cancel(volatile void *out, int snap_to_end) {
+  cancel_slot(find_slot_by_ptr(out), snap_to_end);
+}
+
+void anim_cancel_handle(anim_handle_t handle, int snap_to_end) {
+  cancel_slot(find_slot_by_handle(handle), snap_to_end);
+}
+
+bool anim_running(anim_handle_t handle) {
+  return find_slot_by_handle(handle) >= 0;
+}
+
+// time until a slot reaches the end, at least 1 µs
+static inline uint32_t us_to_end(const anim_slot_t *s) {
+  if (s->spring)
+    return UINT32_MAX; // steps along with any batch, see advance_spring()
+  return s->duration_us - s->elapsed_us;
+}
+
+static inline bool slot_running(const anim_slot_t *s) {
+  // if paused, skip non-sys animations
+  return !g_anim.paused || s->is_sys;
+}
+
+static void finish_slot(uint32_t idx) {
+  anim_slot_t *s = &g_anim.slots[idx];
+  store(s->target, s->channel, s->end); // ensure exact final value
+  if (s->on_done) {
+    g_anim.done[g_anim.done_count].fn = s->on_done;
+    g_anim.done[g_anim.done_count].ctx = s->ctx;
+    g_anim.done_count++;
+  }
+  release_slot(idx);
+}
+
+// integrate a spring in fixed steps (semi-implicit Euler), multiplies and
+// shifts only. time short of a step carries over to the next call. it stops
+// early once at rest, so on_done of a batch can come late by what is left of
+// it.
+static void advance_spring(uint32_t idx, uint32_t us) {
+  anim_slot_t *s = &g_anim.slots[idx];
+  int32_t to_q16 = s->end.i * 65536;
+  int32_t x = s->x_q16;
+  int32_t v = s->v_q16;
+  uint32_t steps = (s->rest_us + us) / ANIM_SPRING_STEP_US;
+  s->rest_us = (s->rest_us + us) % ANIM_SPRING_STEP_US;
+  while (steps--) {
+    int32_t dx = to_q16 - x;
+    int32_t a = (int32_t)(((int64_t)s->k_q24 * dx) >> 24) -
+                (int32_t)(((int64_t)s->c_q24 * v) >> 24);
+    v += a;
+    x += v;
+    if (abs(to_q16 - x) < ANIM_SPRING_REST_Q16 &&
+        abs(v) < ANIM_SPRING_REST_V_Q16) {
+      finish_slot(idx);
+      return;
+    }
+  }
+  s->x_q16 = x;
+  s->v_q16 = v;
+  *(s->out) = spring_value(x);
+}
 
-    // eased progress
-    uint32_t e = anim_apply_ease(s->ease, p_next);
+// advance one slot by `us`, never past its end. a finished slot is released
+// and its on_done queued.
+static void advance_slot(uint32_t idx, uint32_t us) {
+  anim_slot_t *s = &g_anim.slots[idx];
+  if (s->spring) {
+    advance_spring(idx, us);
+    return;
+  }
+  s->elapsed_us += us;
+  if (s->elapsed_us >= s->duration_us) {
+    store(s->target, s->channel, s->end);
+    // timeline tracks go on with their next key, after a delay with key 0
+    if (s->track == NULL || !next_key(s, (uint8_t)(s->key + 1)))
+      finish_slot(idx);
+    return;
+  }
 
-    // value = start + (delta * e)>>16  (Q16.16 scale)
-    int64_t prod = (int64_t)s->delta * (int64_t)e; // up to ~48 bits
-    int32_t inc = (int32_t)(prod >> 16);
-    int32_t val = s->start + inc;
+  // progress in Q16.16, then eased, beyond 0..1 for overshooting curves
+  uint32_t p_q16 = q16_from_ratio(s->elapsed_us, s->duration_us);
+  int32_t e = ease_table(s->curve, p_q16 < 65535u ? p_q16 : 65535u);
+  store(s->target, s->channel, tween_value(s, e));
+}
 
-    *(s->out) = val;
+// advance every running animation. walks the active list backwards, so a
+// release only ever moves an already visited slot into place. on_done
+// callbacks run after the walk and may start or cancel animations freely.
+static void advance_all(uint32_t us) {
+  for (uint32_t i = g_anim.active_count; i-- > 0;) {
+    uint32_t idx = g_anim.active[i];
+    if (slot_running(&g_anim.slots[idx]))
+      advance_slot(idx, us);
+  }
+  for (uint32_t i = 0; i < g_anim.done_count; i++)
+    g_anim.done[i].fn(g_anim.done[i].ctx);
+  g_anim.done_count = 0;
+}
 
-    if (p_next >= 65536u) {
-      *(s->out) = s->end; // ensure exact final value
-      s->active = 0;
-      if (s->on_done)
-        s->on_done(s->ctx);
+void anim_advance(uint32_t us) {
+  // jump ahead to the next completion at a time, so on_done callbacks see
+  // the other animations where they are at that moment
+  while (us > 0) {
+    uint32_t step = us;
+    bool any = false;
+    for (uint32_t i = 0; i < g_anim.active_count; ++i) {
+      anim_slot_t *s = &g_anim.slots[g_anim.active[i]];
+      if (slot_running(s)) {
+        uint32_t left = us_to_end(s);
+        if (left < step)
+          step = left;
+        any = true;
+      }
     }
+    if (!any)
+      return;
+
+    advance_all(step);
+    us -= step;
   }
 }
 
+bool anim_any_active(void) {
+  if (!g_anim.paused)
+    return g_anim.active_count > 0;
+  for (uint32_t i = 0; i < g_anim.active_count; ++i)
+    if (g_anim.slots[g_anim.active[i]].is_sys)
+      return true;
+  return false;
+}
+
 void anim_sys_clear_all() {
-  for (int i = 0; i < ANIM_MAX; ++i)
-    if (!g_anim.slots[i].is_sys)
-      g_anim.slots[i].active = 0;
+  for (uint32_t i = g_anim.active_count; i-- > 0;) {
+    uint32_t idx = g_anim.active[i];
+    if (!g_anim.slots[idx].is_sys)
+      release_slot(idx);
+  }
 }
 
 void anim_sys_set_paused(bool paused) { g_anim.paused = paused; }
@@ -4,39 +4,153 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "ease.h"
+#include "leds.h"
+#include "utils/vec.h"
+
 #ifndef ANIM_MAX
-#define ANIM_MAX 32
+#define ANIM_MAX 32 // up to 65535
+#endif
+// buckets of the target pointer lookup, power of two
+#ifndef ANIM_BUCKETS
+#define ANIM_BUCKETS 32
 #endif
 
-typedef enum {
-  ANIM_EASE_LINEAR,
-  ANIM_EASE_INOUT_QUAD,
-  ANIM_EASE_OUT_CUBIC,
-} anim_ease_t;
+// Animations run on their own microsecond clock, advanced once per frame by
+// anim_advance(), so they keep their timing whatever TICK_RATE is or however
+// few ticks run. durations are in milliseconds.
 
 typedef void (*anim_done_fn)(void *ctx);
 
+// refers to one run of an animation: slot number + 1 in the low half, the
+// slot's generation in the high half. it goes stale once that run finishes
+// or is cancelled, even if the slot is reused. ANIM_NONE is never valid.
+typedef uint32_t anim_handle_t;
+#define ANIM_NONE 0u
+
+// Timelines: keyframe tracks stored as const data and played by the anim
+// system, without callbacks between steps. each track animates one target,
+// waits `delay` ms, then moves from wherever the target is to each key's
+// value in turn, arriving at `at` ms after the delay with that key's
+// ease. tracks of a timeline run in parallel; give one track several keys
+// for sequences, and tracks delays to stagger them. a key at 0 jumps there
+// at the start. a looping track goes on from its last key to its first,
+// keep the last key's `at` the same on all tracks to stay in step.
+typedef struct {
+  uint16_t at; // ms after the track's delay
+  int32_t value;
+  ease_t ease; // towards this key
+} anim_key_t;
+
 typedef struct {
-  volatile int32_t *out; // target integer variable
-  int32_t start;         // start value (int)
-  int32_t end;           // end value (int)
-  int32_t delta;         // end - start
+  uint8_t target; // index into the targets passed to anim_timeline_play()
+  uint8_t key_count;
+  uint16_t delay; // ms
+  const anim_key_t *keys;
+} anim_track_t;
 
-  uint32_t p_q16;  // progress in Q16.16 (0..65536)
-  uint32_t dp_q16; // increment per tick in Q16.16 (≈ 1/duration)
+typedef struct {
+  const anim_track_t *tracks;
+  uint8_t track_count;
+  bool loop;
+} anim_timeline_t;
+
+#define ANIM_TRACK(target_, delay_, keys_)                                     \
+  {.target = (target_),                                                        \
+   .key_count = sizeof(keys_) / sizeof((keys_)[0]),                            \
+   .delay = (delay_),                                                          \
+   .keys = (keys_)}
+
+// a played timeline, for cancelling it. 0 is never used.
+typedef uint16_t anim_group_t;
+
+// springs integrate in fixed steps, whatever the frame time
+#define ANIM_SPRING_STEP_US 1000
+// springs settle once within this distance of the target and this slow
+#define ANIM_SPRING_REST_Q16 (65536 / 4)     // pixels
+#define ANIM_SPRING_REST_V_Q16 (65536 / 256) // pixels per step
+
+// what a slot animates. vec2 and color tweens move every component in the
+// one slot; springs and timelines are int only.
+typedef enum {
+  ANIM_INT,   // int32_t
+  ANIM_VEC2,  // vec2_t, x and y
+  ANIM_COLOR, // color_t, per byte
+} anim_channel_t;
+
+// a value of any channel, by anim_slot_t.channel
+typedef union {
+  int32_t i;
+  vec2_t vec2;
+  color_t color;
+} anim_value_t;
+
+typedef struct {
+  // target variable, by channel
+  union {
+    volatile void *target;
+    volatile int32_t *out;
+    volatile vec2_t *out_vec2;
+    volatile color_t *out_color;
+  };
+  anim_value_t end;
+
+  union {
+    // tween, see anim_to()
+    struct {
+      anim_value_t start;
+      int32_t delta;        // end - start, ints only
+      uint32_t elapsed_us;  // since the start
+      uint32_t duration_us; // until the end
+      const int32_t *curve; // ease table
+    };
+    // spring, see anim_spring_to()
+    struct {
+      int32_t x_q16;    // position in Q16.16
+      int32_t v_q16;    // velocity in Q16.16 per step
+      int32_t k_q24;    // stiffness, omega^2
+      int32_t c_q24;    // damping, 2 * omega
+      uint32_t rest_us; // time towards the next step
+    };
+  };
 
-  anim_ease_t ease;
   uint8_t active;
+  uint8_t channel; // anim_channel_t
+  bool spring;
+  bool loop;
+  uint8_t key;               // timeline key the tween is heading for
+  anim_group_t group;        // timeline it belongs to, 0 = none
+  const anim_track_t *track; // timeline track, NULL for plain tweens
 
   anim_done_fn on_done;
   void *ctx;
 
   bool is_sys; // sys animations are not paused and cancelled by app switch
 
+  uint16_t generation;
+  uint16_t active_at; // index in anim_sys_t.active while active
+  uint16_t next;      // next slot + 1 in the same bucket, 0 = end
 } anim_slot_t;
 
 typedef struct {
   anim_slot_t slots[ANIM_MAX];
+  // running animations, packed, so advancing costs what is active, not
+  // ANIM_MAX
+  uint16_t active[ANIM_MAX];
+  uint16_t active_count;
+  // released slots, and how many slots were ever used
+  uint16_t free[ANIM_MAX];
+  uint16_t free_count;
+  uint16_t used;
+  // active slots by target pointer, slot + 1, 0 = empty
+  uint16_t buckets[ANIM_BUCKETS];
+  // on_done callbacks of the current step, fired once it is done
+  struct {
+    anim_done_fn fn;
+    void *ctx;
+  } done[ANIM_MAX];
+  uint16_t done_count;
+  anim_group_t last_group;
   bool paused;
 } anim_sys_t;
 
@@ -48,19 +162,74 @@ void anim_sys_set_paused(bool paused);
 // clear all non-sys animations (used for scene switches)
 void anim_sys_clear_all();
 // a non-pausable animation (used by system UI)
-int anim_sys_to(volatile int32_t *out, int32_t to, uint32_t duration_ticks,
-                anim_ease_t ease, anim_done_fn on_done, void *ctx);
-
-// a pausable animation (used by apps)
-int anim_to(volatile int32_t *out, int32_t to, uint32_t duration_ticks,
-            anim_ease_t ease, anim_done_fn on_done, void *ctx);
-static inline int anim_by(volatile int32_t *out, int32_t by,
-                          uint32_t duration_ticks, anim_ease_t ease,
-                          anim_done_fn on_done, void *ctx) {
-  return anim_to(out, *out + by, duration_ticks, ease, on_done, ctx);
+anim_handle_t anim_sys_to(volatile int32_t *out, int32_t to,
+                          uint32_t duration_ms, ease_t ease,
+                          anim_done_fn on_done, void *ctx);
+
+// a pausable animation (used by apps). replaces a running animation of the
+// same `out`. returns ANIM_NONE if it finished right away (duration 0) or
+// there was no free slot, `out` is set to `to` then.
+anim_handle_t anim_to(volatile int32_t *out, int32_t to,
+                      uint32_t duration_ms, ease_t ease,
+                      anim_done_fn on_done, void *ctx);
+static inline anim_handle_t anim_by(volatile int32_t *out, int32_t by,
+                                    uint32_t duration_ms, ease_t ease,
+                                    anim_done_fn on_done, void *ctx) {
+  return anim_to(out, *out + by, duration_ms, ease, on_done, ctx);
 }
-void anim_cancel(volatile int32_t *out, int snap_to_end);
-void anim_tick(void);
+// tween both components of a vec2, e.g. an element's position
+anim_handle_t anim_vec2_to(volatile vec2_t *out, vec2_t to,
+                           uint32_t duration_ms, ease_t ease,
+                           anim_done_fn on_done, void *ctx);
+anim_handle_t anim_sys_vec2_to(volatile vec2_t *out, vec2_t to,
+                               uint32_t duration_ms, ease_t ease,
+                               anim_done_fn on_done, void *ctx);
+// fade all four bytes of a color. overshooting eases are clamped to 0..1,
+// so they only change the pace.
+anim_handle_t anim_color_to(volatile color_t *out, color_t to,
+                            uint32_t duration_ms, ease_t ease,
+                            anim_done_fn on_done, void *ctx);
+anim_handle_t anim_sys_color_to(volatile color_t *out, color_t to,
+                                uint32_t duration_ms, ease_t ease,
+                                anim_done_fn on_done, void *ctx);
+// a critically damped spring towards `to`, settling in about settle_ms (at
+// least ~14 ms, shorter ones would not be stable).
+// retargeting a running spring keeps its velocity, so quick successive
+// targets blend instead of restarting. once at rest it snaps to `to`, stops
+// costing anything and calls on_done. replaces a tween of the same `out`.
+anim_handle_t anim_spring_to(volatile int32_t *out, int32_t to,
+                             uint32_t settle_ms, anim_done_fn on_done,
+                             void *ctx);
+// a non-pausable spring (used by system UI)
+anim_handle_t anim_sys_spring_to(volatile int32_t *out, int32_t to,
+                                 uint32_t settle_ms, anim_done_fn on_done,
+                                 void *ctx);
+// play a timeline on targets[track.target]. each track takes one slot (and
+// replaces what else animates its target) until its last key, or until
+// cancelled if the timeline loops. tracks that find no free slot jump to
+// their last key. returns the group for anim_cancel_group().
+anim_group_t anim_timeline_play(const anim_timeline_t *timeline,
+                                volatile int32_t *const *targets);
+// a non-pausable timeline (used by system UI)
+anim_group_t anim_sys_timeline_play(const anim_timeline_t *timeline,
+                                    volatile int32_t *const *targets);
+// stop all tracks of a timeline, snapping targets to their last keys if
+// snap_to_end
+void anim_cancel_group(anim_group_t group, int snap_to_end);
+// true while any track of the timeline runs
+bool anim_group_running(anim_group_t group);
+// stop what animates `out`, of any channel
+void anim_cancel(volatile void *out, int snap_to_end);
+// same without looking `out` up. does nothing if the handle is stale.
+void anim_cancel_handle(anim_handle_t handle, int snap_to_end);
+// true while the run the handle refers to hasn't finished
+bool anim_running(anim_handle_t handle);
+// move the clock on by `us`, in one pass per finishing animation. on_done
+// callbacks fire in order of completion and see every other animation at
+// that time; animations they start only run for the time that is left.
+void anim_advance(uint32_t us);
+// true if any animation will advance with the clock
+bool anim_any_active(void);
 
 static inline uint32_t q16_from_ratio(uint32_t num, uint32_t den) {
   // returns round((num << 16) / den), guarding den==0 at callsites.
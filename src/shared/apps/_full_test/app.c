@@ -3,94 +3,51 @@
 #include <hardware/watchdog.h>
 
 #include <shared/apps/apps.h>
+#include <shared/audio/sequencer.h>
 
-static const unsigned char image_Sprite_0001_bits[] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x01,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0xff, 0x00, 0x87, 0x0f, 0x1c,
-    0x00, 0xff, 0xc1, 0xe3, 0xe1, 0x07, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff,
-    0x83, 0xef, 0x1f, 0x3e, 0xe0, 0xff, 0xe3, 0xf3, 0xf7, 0x0f, 0x00, 0x00,
-    0x00, 0x00, 0xf0, 0xff, 0x87, 0xff, 0x3f, 0x3e, 0xf0, 0xff, 0xe3, 0xfb,
-    0xff, 0x1f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0x8f, 0xff, 0x3f, 0x3e,
-    0xf8, 0xff, 0xe3, 0xff, 0xff, 0x1f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff,
-    0x8f, 0xff, 0x3f, 0x3e, 0xf8, 0xff, 0xe3, 0xff, 0xff, 0x1f, 0x00, 0x00,
-    0x00, 0x00, 0xf0, 0x87, 0x8f, 0x7f, 0x3e, 0x3e, 0xf8, 0xc0, 0xe1, 0xdf,
-    0xbf, 0x1f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x03, 0x9f, 0x3f, 0x3c, 0x3e,
-    0xf8, 0x00, 0xe0, 0xcf, 0x0f, 0x1f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01,
-    0x9f, 0x1f, 0x18, 0x3e, 0xf0, 0x03, 0xe0, 0xc7, 0x07, 0x1f, 0x00, 0x00,
-    0x00, 0x00, 0xf0, 0x01, 0x9f, 0x0f, 0x00, 0x3e, 0xf0, 0x0f, 0xe0, 0xc7,
-    0x07, 0x1f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x9f, 0x0f, 0x00, 0x3e,
-    0xe0, 0x3f, 0xe0, 0xc3, 0x07, 0x1f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01,
-    0x9f, 0x0f, 0x00, 0x3e, 0x80, 0xff, 0xe0, 0xc3, 0x07, 0x3f, 0x00, 0x00,
-    0x00, 0x00, 0xf0, 0x01, 0x9f, 0x0f, 0x00, 0x3e, 0x00, 0xfe, 0xe1, 0x83,
-    0x0f, 0x3f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x9f, 0x0f, 0x00, 0x3e,
-    0x00, 0xf0, 0xe3, 0x83, 0x0f, 0x3f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x81,
-    0x9f, 0x0f, 0x00, 0x3e, 0x00, 0xe0, 0xe3, 0x83, 0x0f, 0x3f, 0x00, 0x00,
-    0x00, 0x00, 0xf0, 0xc1, 0x8f, 0x0f, 0x00, 0x3e, 0x78, 0xf0, 0xe3, 0x83,
-    0x0f, 0x3e, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0x8f, 0x0f, 0x00, 0x3e,
-    0xfc, 0xff, 0xe3, 0x83, 0x0f, 0x3e, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff,
-    0x87, 0x0f, 0x00, 0x3e, 0xfc, 0xff, 0xe1, 0x83, 0x0f, 0x3e, 0x00, 0x00,
-    0x00, 0x00, 0xf0, 0xff, 0x83, 0x0f, 0x00, 0x3e, 0xfc, 0xff, 0xe1, 0x83,
-    0x0f, 0x3e, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0x81, 0x0f, 0x00, 0x3e,
-    0xf8, 0x7f, 0xe0, 0x83, 0x0f, 0x3e, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x7f,
-    0x00, 0x07, 0x00, 0x1c, 0xc0, 0x1f, 0xc0, 0x81, 0x0f, 0x3e, 0x00, 0x00,
-    0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x07, 0x1c, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00};
+#include "sprites.h"
+
+// background loop played by the sequencer on voices 2-3
+static const audio_synth_instrument_t song_instruments[] = {
+    // 0: soft bass
+    {.ops = {{.freq_mult = 0,
+              .level = Q1X15_C(0.3f),
+              .mode = AUDIO_SYNTH_OP_MODE_ADDITIVE,
+              .env = {.a = 2, .d = 150, .s = Q1X31_C(0.3), .r = 60}}}},
+    // 1: pluck
+    {.ops = {{.freq_mult = 2,
+              .level = Q1X15_C(0.2f),
+              .mode = AUDIO_SYNTH_OP_MODE_ADDITIVE,
+              .env = {.a = 0, .d = 120, .s = Q1X31_C(0.0), .r = 40}}}},
+};
+
+static const uint8_t song_pattern_0[] = {
+    8,
+    0x03, AUDIO_SEQ_NOTE_INST(36, 0), AUDIO_SEQ_NOTE_INST(60, 1),
+    0x02, AUDIO_SEQ_NOTE(67),
+    0x03, AUDIO_SEQ_NOTE(AUDIO_SEQ_NOTE_OFF), AUDIO_SEQ_NOTE(72),
+    0x02, AUDIO_SEQ_NOTE(67),
+    0x03, AUDIO_SEQ_NOTE(43), AUDIO_SEQ_NOTE(62),
+    0x02, AUDIO_SEQ_NOTE(67),
+    0x03, AUDIO_SEQ_NOTE(AUDIO_SEQ_NOTE_OFF), AUDIO_SEQ_NOTE(71),
+    0x02, AUDIO_SEQ_NOTE(67),
+};
+
+static const uint8_t *const song_patterns[] = {song_pattern_0};
+static const uint8_t song_order[] = {0};
+
+static const audio_synth_song_t song = {
+    .channels = 2,
+    .bpm = 100,
+    .rows_per_beat = 2,
+    .swing = 40,
+    .order_count = 1,
+    .restart = 0,
+    .order = song_order,
+    .patterns = song_patterns,
+    .instruments = song_instruments,
+    .instrument_count = 2,
+};
 
 static void enter() {
   audio_synth_operator_config_t config = audio_synth_operator_config_default;
@@ -116,14 +73,19 @@ static void enter() {
   config.mode = AUDIO_SYNTH_OP_MODE_FREQ_MOD;
   audio_synth_operator_set_config(&g_engine.synth.voices[0].ops[1], config);
   audio_synth_operator_set_config(&g_engine.synth.voices[1].ops[1], config);
+
+  audio_synth_enqueue(&g_engine.synth,
+                      &(audio_synth_message_t){
+                          .type = AUDIO_SYNTH_MESSAGE_SONG_PLAY,
+                          .data.song_play = {.song = &song, .voice = 2},
+                      });
 }
 
 static void frame() {
   static uint8_t i = 0;
   u8g2_t *u8g2 = &g_engine.display.u8g2;
 
-  u8g2_SetBitmapMode(u8g2, 1);
-  u8g2_DrawXBM(u8g2, 0, 0, 128, 64, image_Sprite_0001_bits);
+  sprite_draw(u8g2, 0, 0, &image_Sprite_0001_sprite, SPRITE_OR);
   g_engine.leds.colors[0].hex = 0x00d9ff;
   g_engine.leds.colors[1].hex = 0xff7700;
 
@@ -167,7 +129,7 @@ static void frame() {
                               .data.note_on =
                                   {
                                       .voice = 0,
-                                      .note_number = note("C4"),
+                                      .note_number = NOTE(C, 4),
                                       .velocity = 100,
                                   },
                           });
@@ -187,7 +149,7 @@ static void frame() {
                               .data.note_on =
                                   {
                                       .voice = 1,
-                                      .note_number = note("G4"),
+                                      .note_number = NOTE(G, 4),
                                       .velocity = 100,
                                   },
                           });
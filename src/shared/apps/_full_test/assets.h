@@ -0,0 +1,95 @@
+// image assets, in the XBM format scripts/export.sh writes (this app has no
+// aseprite sources)
+#pragma once
+#include <stdint.h>
+
+#define image_Sprite_0001_width 128
+#define image_Sprite_0001_height 64
+static const uint8_t image_Sprite_0001_bits[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0xff, 0x00, 0x87, 0x0f, 0x1c,
+    0x00, 0xff, 0xc1, 0xe3, 0xe1, 0x07, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff,
+    0x83, 0xef, 0x1f, 0x3e, 0xe0, 0xff, 0xe3, 0xf3, 0xf7, 0x0f, 0x00, 0x00,
+    0x00, 0x00, 0xf0, 0xff, 0x87, 0xff, 0x3f, 0x3e, 0xf0, 0xff, 0xe3, 0xfb,
+    0xff, 0x1f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0x8f, 0xff, 0x3f, 0x3e,
+    0xf8, 0xff, 0xe3, 0xff, 0xff, 0x1f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff,
+    0x8f, 0xff, 0x3f, 0x3e, 0xf8, 0xff, 0xe3, 0xff, 0xff, 0x1f, 0x00, 0x00,
+    0x00, 0x00, 0xf0, 0x87, 0x8f, 0x7f, 0x3e, 0x3e, 0xf8, 0xc0, 0xe1, 0xdf,
+    0xbf, 0x1f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x03, 0x9f, 0x3f, 0x3c, 0x3e,
+    0xf8, 0x00, 0xe0, 0xcf, 0x0f, 0x1f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01,
+    0x9f, 0x1f, 0x18, 0x3e, 0xf0, 0x03, 0xe0, 0xc7, 0x07, 0x1f, 0x00, 0x00,
+    0x00, 0x00, 0xf0, 0x01, 0x9f, 0x0f, 0x00, 0x3e, 0xf0, 0x0f, 0xe0, 0xc7,
+    0x07, 0x1f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x9f, 0x0f, 0x00, 0x3e,
+    0xe0, 0x3f, 0xe0, 0xc3, 0x07, 0x1f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01,
+    0x9f, 0x0f, 0x00, 0x3e, 0x80, 0xff, 0xe0, 0xc3, 0x07, 0x3f, 0x00, 0x00,
+    0x00, 0x00, 0xf0, 0x01, 0x9f, 0x0f, 0x00, 0x3e, 0x00, 0xfe, 0xe1, 0x83,
+    0x0f, 0x3f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x9f, 0x0f, 0x00, 0x3e,
+    0x00, 0xf0, 0xe3, 0x83, 0x0f, 0x3f, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x81,
+    0x9f, 0x0f, 0x00, 0x3e, 0x00, 0xe0, 0xe3, 0x83, 0x0f, 0x3f, 0x00, 0x00,
+    0x00, 0x00, 0xf0, 0xc1, 0x8f, 0x0f, 0x00, 0x3e, 0x78, 0xf0, 0xe3, 0x83,
+    0x0f, 0x3e, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0x8f, 0x0f, 0x00, 0x3e,
+    0xfc, 0xff, 0xe3, 0x83, 0x0f, 0x3e, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff,
+    0x87, 0x0f, 0x00, 0x3e, 0xfc, 0xff, 0xe1, 0x83, 0x0f, 0x3e, 0x00, 0x00,
+    0x00, 0x00, 0xf0, 0xff, 0x83, 0x0f, 0x00, 0x3e, 0xfc, 0xff, 0xe1, 0x83,
+    0x0f, 0x3e, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0x81, 0x0f, 0x00, 0x3e,
+    0xf8, 0x7f, 0xe0, 0x83, 0x0f, 0x3e, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x7f,
+    0x00, 0x07, 0x00, 0x1c, 0xc0, 0x1f, 0xc0, 0x81, 0x0f, 0x3e, 0x00, 0x00,
+    0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x07, 0x1c, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00};
+
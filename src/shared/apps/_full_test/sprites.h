@@ -0,0 +1,45 @@
+// This file is auto-generated by scripts/bake.py. Do not edit manually.
+
+#pragma once
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "shared/sprite.h"
+
+
+static const uint8_t image_Sprite_0001_sprite_bits[278] = {
+  0xff, 0x00, 0xb7, 0x00, 0x00, 0x80, 0x81, 0xc0, 0x00, 0x80, 0xd3, 0x00,
+  0x00, 0x80, 0x80, 0xc0, 0x00, 0x80, 0x86, 0xc0, 0x80, 0x80, 0x83, 0x00,
+  0x00, 0x80, 0x81, 0xc0, 0x01, 0x80, 0x00, 0x80, 0x80, 0x83, 0xc0, 0x00,
+  0x80, 0x82, 0x00, 0x01, 0x80, 0xc3, 0x80, 0xc7, 0x01, 0x87, 0x03, 0x84,
+  0x00, 0x81, 0x80, 0x87, 0xc0, 0x00, 0x80, 0x81, 0x00, 0x00, 0x80, 0x81,
+  0xe0, 0x00, 0xc0, 0x80, 0x00, 0x00, 0x80, 0x82, 0xc0, 0x80, 0x80, 0x01,
+  0x00, 0x80, 0x84, 0xc0, 0x00, 0x80, 0xa6, 0x00, 0x83, 0xff, 0x01, 0x1f,
+  0x0f, 0x82, 0x07, 0x00, 0x0f, 0x81, 0xff, 0x01, 0xfe, 0xf0, 0x80, 0x00,
+  0x83, 0xff, 0x02, 0x3f, 0x1f, 0x0f, 0x80, 0x07, 0x01, 0x0f, 0x1f, 0x80,
+  0x3f, 0x00, 0x1f, 0x81, 0x00, 0x83, 0xff, 0x83, 0x00, 0x01, 0x1e, 0x7f,
+  0x81, 0xff, 0x80, 0xe7, 0x80, 0xc7, 0x80, 0x87, 0x81, 0x0f, 0x00, 0x07,
+  0x81, 0x00, 0x83, 0xff, 0x03, 0x7e, 0x1f, 0x0f, 0x07, 0x83, 0xff, 0x00,
+  0x1f, 0x80, 0x0f, 0x01, 0x07, 0x0f, 0x83, 0xff, 0xa5, 0x00, 0x83, 0xff,
+  0x83, 0xe0, 0x01, 0xf0, 0xf8, 0x80, 0xff, 0x02, 0x7f, 0x3f, 0x0f, 0x80,
+  0x00, 0x83, 0xff, 0x8b, 0x00, 0x83, 0xff, 0x82, 0x00, 0x00, 0xe0, 0x82,
+  0xf0, 0x80, 0xe1, 0x81, 0xe3, 0x00, 0xf7, 0x81, 0xff, 0x01, 0xfe, 0x3c,
+  0x81, 0x00, 0x83, 0xff, 0x82, 0x00, 0x00, 0x01, 0x82, 0xff, 0x00, 0xfe,
+  0x82, 0x00, 0x00, 0x0f, 0x83, 0xff, 0xa4, 0x00, 0x83, 0xff, 0x84, 0x03,
+  0x80, 0x01, 0x84, 0x00, 0x00, 0x01, 0x81, 0x03, 0x00, 0x01, 0x8b, 0x00,
+  0x00, 0x01, 0x81, 0x03, 0x00, 0x01, 0x83, 0x00, 0x81, 0x01, 0x85, 0x03,
+  0x80, 0x01, 0x84, 0x00, 0x00, 0x01, 0x81, 0x03, 0x00, 0x01, 0x83, 0x00,
+  0x00, 0x03, 0x81, 0x07, 0x00, 0x03, 0x83, 0x00, 0x00, 0x03, 0x81, 0x07,
+  0x00, 0x03, 0xa4, 0x00, 0x00, 0x03, 0x81, 0x07, 0x00, 0x03, 0xff, 0x00,
+  0xe4, 0x00,
+};
+
+static const sprite_t image_Sprite_0001_sprite = {
+  .width = 128,
+  .height = 64,
+  .rows = 8,
+  .shifts = 1,
+  .compressed = true,
+  .bits = image_Sprite_0001_sprite_bits,
+};
@@ -2,9 +2,26 @@
 
 #include <shared/anim.h>
 #include <shared/apps/apps.h>
+#include <shared/audio/tune.h>
 #include <shared/engine.h>
 #include <shared/utils/vec.h>
 
+// instruments for the baked tunes in music/, referenced by music.h
+static const audio_synth_instrument_t boot_instruments[] = {
+    // 0: bell
+    {.ops = {{.freq_mult = 2,
+              .level = Q1X15_C(0.25f),
+              .mode = AUDIO_SYNTH_OP_MODE_ADDITIVE,
+              .env = {.a = 1, .d = 250, .s = Q1X31_C(0.1), .r = 150}}}},
+    // 1: pad
+    {.ops = {{.freq_mult = 1,
+              .level = Q1X15_C(0.2f),
+              .mode = AUDIO_SYNTH_OP_MODE_ADDITIVE,
+              .env = {.a = 40, .d = 200, .s = Q1X31_C(0.5), .r = 300}}}},
+};
+
+#include "music.h"
+
 static const int16_t APP_SIZE = 36;
 static const int16_t APP_MARGIN = 8;
 static const int16_t APP_SCROLL_MARGIN =
@@ -21,7 +38,8 @@ static struct {
   bool ignore_release;
   int32_t active_offset;
   int32_t scroll_offset;
-  uint32_t held_width;
+  int32_t held_width;
+  bool booted;
   button_id_t held_button;
 } state = {
     .scroll_offset = APP_SCROLL_MARGIN,
@@ -41,47 +59,50 @@ static void change_active(int8_t delta) {
 
   // scroll to active
   int32_t offset = app_x(state.active);
-  anim_to(&state.active_offset, offset, 150, ANIM_EASE_INOUT_QUAD, NULL, NULL);
+  anim_spring_to(&state.active_offset, offset, 200, NULL, NULL);
   int32_t scroll_idx = state.active / 2;
   int32_t scroll_offset =
       APP_SCROLL_MARGIN - (APP_SIZE + APP_MARGIN) * 2 * scroll_idx;
-  anim_to(&state.scroll_offset, scroll_offset, 150, ANIM_EASE_INOUT_QUAD, NULL,
-          NULL);
-}
-
-static inline float ease_out_cubic(float t) {
-  float inv = 1.0f - t;
-  return 1.0f - inv * inv * inv;
+  anim_spring_to(&state.scroll_offset, scroll_offset, 200, NULL, NULL);
 }
 
 static void enter() {
   state.ignore_release = false;
   state.held_width = 0;
+
+  if (!state.booted) {
+    state.booted = true;
+    audio_synth_enqueue(&g_engine.synth,
+                        &(audio_synth_message_t){
+                            .type = AUDIO_SYNTH_MESSAGE_TUNE_PLAY,
+                            .data.tune_play = {.tune = &tune_boot, .voice = 0},
+                        });
+  }
 }
 
 static void frame() {
   button_id_t button_id = engine_button_get_pressed_first();
   if (button_id != BUTTON_NONE) {
-    float held = engine_button_held_ratio(button_id);
-    state.ignore_release = held > 0.f;
-    if (held >= 1.f) {
+    uint32_t held = engine_button_held_q16(button_id);
+    state.ignore_release = held > 0;
+    if (held >= 65536) {
       engine_set_app(apps[state.active]);
     }
     if (held > 0) {
       anim_cancel(&state.held_width, false);
-      state.held_width = APP_SIZE * ease_out_cubic(held);
+      state.held_width = ease_scale(EASE_OUT_CUBIC, held, APP_SIZE);
       state.held_button = button_id;
     } // otherwise use the existing value instead of overwriting it.
   }
 
   if (BUTTON_KEYUP(BUTTON_LEFT)) {
-    anim_to(&state.held_width, 0, 150, ANIM_EASE_OUT_CUBIC, NULL, NULL);
+    anim_to(&state.held_width, 0, 150, EASE_OUT_CUBIC, NULL, NULL);
     if (!state.ignore_release)
       change_active(-1);
   }
 
   if (BUTTON_KEYUP(BUTTON_RIGHT)) {
-    anim_to(&state.held_width, 0, 150, ANIM_EASE_OUT_CUBIC, NULL, NULL);
+    anim_to(&state.held_width, 0, 150, EASE_OUT_CUBIC, NULL, NULL);
     if (!state.ignore_release)
       change_active(1);
   }
@@ -93,7 +114,7 @@ static void frame() {
     vec2_t pos = vec2(state.scroll_offset + app_x(i), 11);
     u8g2_SetDrawColor(u8g2, 1);
     if (apps[i]->icon) {
-      u8g2_DrawXBM(u8g2, pos.x, pos.y, APP_SIZE, APP_SIZE, apps[i]->icon);
+      sprite_draw(u8g2, pos.x, pos.y, apps[i]->icon, SPRITE_OR);
     }
     if (i == state.active) {
       u8g2_SetDrawColor(u8g2, 2);
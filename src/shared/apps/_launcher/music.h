@@ -0,0 +1,31 @@
+// This file is auto-generated by scripts/bake.py. Do not edit manually.
+
+#pragma once
+
+
+#include "shared/audio/tune.h"
+
+
+static const audio_synth_event_t tune_boot_track_0[14] = {
+  {0, 129, 0}, {0, 72, 90}, {75, 128, 0}, {25, 76, 90}, {75, 128, 0}, {25, 79, 90},
+  {75, 128, 0}, {25, 84, 90}, {225, 128, 0}, {75, 79, 90}, {38, 128, 0}, {12, 84, 90},
+  {300, 128, 0}, {100, 255, 0},
+};
+
+static const audio_synth_event_t tune_boot_track_1[8] = {
+  {0, 129, 1}, {200, 48, 70}, {600, 128, 0}, {0, 43, 70}, {200, 128, 0}, {0, 48, 70},
+  {400, 128, 0}, {0, 255, 0},
+};
+
+static const audio_synth_event_t *const tune_boot_tracks[] = {
+  tune_boot_track_0,
+  tune_boot_track_1,
+};
+
+static const audio_synth_tune_t tune_boot = {
+  .track_count = 2,
+  .tracks = tune_boot_tracks,
+  .instruments = boot_instruments,
+  .instrument_count = sizeof(boot_instruments) / sizeof(boot_instruments[0]),
+  .loop = false,
+};
@@ -1,8 +1,13 @@
-#include "assets.h"
+#include "sprites.h"
 #include <shared/apps/apps.h>
 #include <shared/engine.h>
 
+static sprite_player_t *cat;
+
 static void enter() {
+  cat = engine_alloc(sizeof(*cat));
+  sprite_player_init(cat, &cat_anim);
+
   audio_synth_operator_config_t config = audio_synth_operator_config_default;
   config.env = (audio_synth_env_config_t){
       .a = 2,
@@ -26,9 +31,14 @@ static void enter() {
   config.mode = AUDIO_SYNTH_OP_MODE_FREQ_MOD;
   audio_synth_operator_set_config(&g_engine.synth.voices[0].ops[1], config);
   audio_synth_operator_set_config(&g_engine.synth.voices[1].ops[1], config);
+
+  // pulse the LEDs with the drums
+  audio_analysis_set_enabled(&g_engine.synth.analysis, true);
 }
 
-static void tick() {
+// only reacts to edges, so the rest of the frame's ticks cost nothing
+static void tick_n(uint32_t n) {
+  (void)n;
   if (g_engine.buttons.left.edge) {
     if (g_engine.buttons.left.pressed) {
       audio_synth_enqueue(&g_engine.synth,
@@ -78,23 +88,39 @@ static void frame() {
   bool right = BUTTON_PRESSED(BUTTON_RIGHT);
   bool breathe = (g_engine.tick / 500) % 2;
 
-  const uint8_t *cat = cat_idle_0_bits;
+  uint8_t pose = CAT_IDLE_0;
   if (left && right) {
-    cat = cat_both_0_bits;
+    pose = CAT_BOTH_0;
   } else if (left) {
-    cat = cat_left_0_bits;
+    pose = CAT_LEFT_0;
   } else if (right) {
-    cat = cat_right_0_bits;
+    pose = CAT_RIGHT_0;
   } else if (breathe) {
-    cat = cat_idle_1_bits;
+    pose = CAT_IDLE_1;
   }
-  u8g2_DrawXBM(u8g2, 0, 0, 128, 64, cat);
+  // only XORs the paws and face that change, then a memcpy per row
+  sprite_player_set_frame(cat, pose);
+  sprite_draw(u8g2, 0, 0, &cat->sprite, SPRITE_COPY);
+
+  // glow with the output level
+  audio_analysis_snapshot_t level;
+  audio_analysis_read(&g_engine.synth.analysis, &level);
+  uint8_t glow = MIN(level.rms >> 5, 255);
+  g_engine.leds.colors[LED_L] = rgba(glow, glow / 4, 0, 255);
+  g_engine.leds.colors[LED_R] = rgba(0, glow / 4, glow, 255);
+  if (glow)
+    engine_request_redraw(); // keep the LEDs smooth while the drums ring
+}
+
+static void leave() {
+  cat = NULL; // engine_alloc() memory goes with the app
 }
 
 app_t app_bongocat = {
     .name = "bongocat",
-    .icon = icon__0_bits,
+    .icon = &icon__0_sprite,
     .enter = enter,
-    .tick = tick,
+    .leave = leave,
+    .tick_n = tick_n,
     .frame = frame,
 };
@@ -0,0 +1,162 @@
+// This file is auto-generated by scripts/bake.py. Do not edit manually.
+
+#pragma once
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "shared/sprite.h"
+
+
+#define CAT_BOTH_0 0
+#define CAT_IDLE_0 1
+#define CAT_IDLE_1 2
+#define CAT_LEFT_0 3
+#define CAT_RIGHT_0 4
+
+static const uint8_t cat_key_sprite_bits[358] = {
+  0xa1, 0x00, 0x03, 0x80, 0x70, 0x08, 0x06, 0x81, 0x01, 0x03, 0x02, 0x04,
+  0x18, 0x20, 0x86, 0x40, 0x9a, 0x20, 0x81, 0x40, 0x80, 0x80, 0x87, 0x00,
+  0x01, 0x80, 0x40, 0x81, 0x20, 0x00, 0xc0, 0xb7, 0x00, 0x04, 0x80, 0x40,
+  0x20, 0x10, 0x0f, 0xb1, 0x00, 0x03, 0x01, 0x02, 0x06, 0x04, 0x80, 0x08,
+  0x02, 0x04, 0x02, 0x01, 0x84, 0x00, 0x01, 0x0f, 0xf0, 0xa7, 0x00, 0x02,
+  0xe0, 0x18, 0x04, 0x82, 0x02, 0x80, 0x04, 0x04, 0x08, 0x10, 0x60, 0x82,
+  0x01, 0x85, 0x00, 0x00, 0xe0, 0x81, 0xf0, 0x00, 0xe0, 0xab, 0x00, 0x01,
+  0x80, 0x40, 0x82, 0x20, 0x01, 0x40, 0x80, 0x85, 0x00, 0x02, 0x07, 0x18,
+  0xe0, 0xa5, 0x00, 0x01, 0x3f, 0xc0, 0x88, 0x00, 0x03, 0x03, 0x0c, 0x10,
+  0x60, 0x84, 0x00, 0x81, 0x01, 0x86, 0x00, 0x01, 0x30, 0x40, 0x85, 0x80,
+  0x03, 0x40, 0x20, 0x40, 0x80, 0x84, 0x00, 0x01, 0x80, 0x40, 0x85, 0x00,
+  0x00, 0x0e, 0x81, 0x1f, 0x00, 0x0e, 0x81, 0x00, 0x01, 0xfc, 0x03, 0x85,
+  0x00, 0x04, 0x01, 0x06, 0x18, 0x60, 0x80, 0x84, 0x00, 0x01, 0x7f, 0x80,
+  0x92, 0x00, 0x86, 0x40, 0x89, 0x80, 0x02, 0x83, 0x8c, 0x90, 0x82, 0x00,
+  0x00, 0x80, 0x80, 0x40, 0x80, 0x20, 0x82, 0x10, 0x8a, 0x08, 0x82, 0x10,
+  0x80, 0x20, 0x80, 0x40, 0x00, 0x80, 0x85, 0x00, 0x84, 0x01, 0x8f, 0x00,
+  0x03, 0x03, 0x0c, 0x30, 0xc0, 0x87, 0x00, 0x02, 0x01, 0x02, 0x04, 0x83,
+  0x00, 0x01, 0x1f, 0xe0, 0xa7, 0x00, 0x80, 0x01, 0x02, 0x00, 0x3f, 0xe8,
+  0x80, 0x50, 0x80, 0xa0, 0x82, 0x40, 0x8a, 0x80, 0x82, 0x40, 0x80, 0xa0,
+  0x80, 0x50, 0x02, 0xe8, 0x3f, 0x00, 0x84, 0x04, 0x03, 0x08, 0xe0, 0x90,
+  0x08, 0x80, 0x04, 0x82, 0x02, 0x88, 0x01, 0x82, 0x02, 0x80, 0x04, 0x03,
+  0x09, 0x90, 0xe0, 0x00, 0x8a, 0x20, 0x8c, 0x40, 0x86, 0x80, 0x98, 0x00,
+  0x02, 0x03, 0x3c, 0xc0, 0x80, 0x00, 0x01, 0x01, 0x93, 0x80, 0x01, 0x8a,
+  0x02, 0x80, 0x01, 0x01, 0x93, 0x01, 0x80, 0x00, 0x02, 0xc0, 0x3c, 0x03,
+  0x87, 0x00, 0x02, 0x03, 0xfe, 0x05, 0x80, 0x0a, 0x03, 0x14, 0x34, 0x14,
+  0x2c, 0x88, 0x28, 0x03, 0x2c, 0x14, 0x34, 0x14, 0x80, 0x0a, 0x02, 0x05,
+  0xfe, 0x03, 0xbd, 0x00, 0x02, 0x03, 0x04, 0x08, 0x80, 0x10, 0x01, 0x14,
+  0x10, 0x8a, 0x20, 0x01, 0x10, 0x14, 0x80, 0x10, 0x02, 0x08, 0x04, 0x03,
+  0x8b, 0x00, 0x01, 0x0f, 0x10, 0x80, 0x20, 0x01, 0x21, 0x28, 0x8a, 0x40,
+  0x01, 0x28, 0x21, 0x80, 0x20, 0x01, 0x10, 0x0f, 0xa3, 0x00,
+};
+
+static const sprite_t cat_key_sprite = {
+  .width = 128,
+  .height = 64,
+  .rows = 8,
+  .shifts = 1,
+  .compressed = true,
+  .bits = cat_key_sprite_bits,
+};
+
+static const uint8_t cat_both_0_delta[175] = {
+  0x02, 0x11, 0x0d, 0xe0, 0x18, 0x04, 0x02, 0x02, 0x02, 0x02, 0x04, 0xc4,
+  0x28, 0x08, 0x64, 0x80, 0x02, 0x58, 0x08, 0x80, 0x40, 0x20, 0x20, 0x20,
+  0x20, 0x40, 0x80, 0x03, 0x11, 0x02, 0x3f, 0xc0, 0x03, 0x17, 0x03, 0xf0,
+  0x0e, 0x01, 0x03, 0x1d, 0x04, 0x03, 0x0c, 0x10, 0x60, 0x03, 0x24, 0x02,
+  0x30, 0xc0, 0x03, 0x56, 0x02, 0xfc, 0x03, 0x03, 0x5f, 0x05, 0x01, 0x06,
+  0x18, 0x60, 0x80, 0x04, 0x13, 0x1c, 0x03, 0x0c, 0x10, 0x00, 0x03, 0x0c,
+  0x10, 0xa0, 0x00, 0xc0, 0x20, 0x20, 0x10, 0x10, 0x10, 0x10, 0x08, 0x08,
+  0x08, 0x09, 0x0a, 0x0c, 0x00, 0x00, 0x18, 0x18, 0x28, 0xc8, 0x04, 0x4d,
+  0x0d, 0x80, 0x40, 0x40, 0x40, 0x40, 0x20, 0x20, 0x10, 0x10, 0x0b, 0x08,
+  0x32, 0xc1, 0x04, 0x63, 0x04, 0x81, 0x42, 0x34, 0x08, 0x05, 0x1d, 0x12,
+  0x01, 0x01, 0x02, 0x02, 0x04, 0x04, 0x04, 0x04, 0x08, 0x08, 0x08, 0x08,
+  0x08, 0x08, 0x04, 0x04, 0x02, 0x01, 0x05, 0x4a, 0x19, 0x01, 0x3f, 0x40,
+  0x81, 0x81, 0x01, 0x01, 0x01, 0x01, 0x01, 0x82, 0x82, 0x82, 0x82, 0x84,
+  0x44, 0x49, 0xb0, 0x40, 0x10, 0x08, 0x04, 0x04, 0x02, 0x01, 0x06, 0x4f,
+  0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0xff,
+};
+
+static const uint8_t cat_idle_0_delta[1] = {
+  0xff,
+};
+
+static const uint8_t cat_idle_1_delta[207] = {
+  0x00, 0x23, 0x34, 0x80, 0xb0, 0x28, 0x1e, 0x05, 0x05, 0x05, 0x0a, 0x14,
+  0x78, 0xa0, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0xa0, 0xa0,
+  0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0,
+  0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0,
+  0xa0, 0xa0, 0x40, 0x40, 0x40, 0x80, 0x80, 0x00, 0x60, 0x06, 0x80, 0x40,
+  0xa0, 0xa0, 0xa0, 0xc0, 0x01, 0x1f, 0x06, 0x80, 0x40, 0xa0, 0x50, 0x31,
+  0x01, 0x01, 0x2e, 0x08, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+  0x01, 0x52, 0x10, 0x01, 0x01, 0x01, 0x02, 0x02, 0x05, 0x0a, 0x1e, 0x14,
+  0x28, 0x28, 0x14, 0x0a, 0x05, 0x02, 0x01, 0x01, 0x65, 0x03, 0x03, 0x33,
+  0x30, 0x02, 0x1d, 0x04, 0x02, 0x05, 0x02, 0x01, 0x02, 0x26, 0x05, 0x60,
+  0x30, 0x30, 0x30, 0x60, 0x02, 0x67, 0x03, 0x18, 0x78, 0x60, 0x03, 0x26,
+  0x05, 0x03, 0x06, 0x06, 0x06, 0x03, 0x03, 0x32, 0x0d, 0xf0, 0x40, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x40, 0xa0, 0x40, 0x80, 0x03, 0x45,
+  0x02, 0x80, 0x40, 0x03, 0x4e, 0x05, 0x36, 0x63, 0x63, 0x63, 0x36, 0x03,
+  0x69, 0x03, 0x03, 0x83, 0x80, 0x04, 0x33, 0x14, 0x01, 0x02, 0x02, 0x02,
+  0x02, 0x02, 0x02, 0x02, 0x01, 0x00, 0x01, 0x02, 0x05, 0x05, 0x05, 0x05,
+  0x05, 0x05, 0x02, 0x01, 0x04, 0x6a, 0x03, 0x01, 0x61, 0x60, 0x05, 0x6c,
+  0x01, 0x03, 0xff,
+};
+
+static const uint8_t cat_left_0_delta[92] = {
+  0x02, 0x11, 0x0d, 0xe0, 0x18, 0x04, 0x02, 0x02, 0x02, 0x02, 0x04, 0xc4,
+  0x28, 0x08, 0x64, 0x80, 0x03, 0x11, 0x02, 0x3f, 0xc0, 0x03, 0x17, 0x03,
+  0xf0, 0x0e, 0x01, 0x03, 0x1d, 0x04, 0x03, 0x0c, 0x10, 0x60, 0x03, 0x24,
+  0x02, 0x30, 0xc0, 0x04, 0x13, 0x1c, 0x03, 0x0c, 0x10, 0x00, 0x03, 0x0c,
+  0x10, 0xa0, 0x00, 0xc0, 0x20, 0x20, 0x10, 0x10, 0x10, 0x10, 0x08, 0x08,
+  0x08, 0x09, 0x0a, 0x0c, 0x00, 0x00, 0x18, 0x18, 0x28, 0xc8, 0x05, 0x1d,
+  0x12, 0x01, 0x01, 0x02, 0x02, 0x04, 0x04, 0x04, 0x04, 0x08, 0x08, 0x08,
+  0x08, 0x08, 0x08, 0x04, 0x04, 0x02, 0x01, 0xff,
+};
+
+static const uint8_t cat_right_0_delta[84] = {
+  0x02, 0x58, 0x08, 0x80, 0x40, 0x20, 0x20, 0x20, 0x20, 0x40, 0x80, 0x03,
+  0x56, 0x02, 0xfc, 0x03, 0x03, 0x5f, 0x05, 0x01, 0x06, 0x18, 0x60, 0x80,
+  0x04, 0x4d, 0x0d, 0x80, 0x40, 0x40, 0x40, 0x40, 0x20, 0x20, 0x10, 0x10,
+  0x0b, 0x08, 0x32, 0xc1, 0x04, 0x63, 0x04, 0x81, 0x42, 0x34, 0x08, 0x05,
+  0x4a, 0x19, 0x01, 0x3f, 0x40, 0x81, 0x81, 0x01, 0x01, 0x01, 0x01, 0x01,
+  0x82, 0x82, 0x82, 0x82, 0x84, 0x44, 0x49, 0xb0, 0x40, 0x10, 0x08, 0x04,
+  0x04, 0x02, 0x01, 0x06, 0x4f, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0xff,
+};
+
+static const uint8_t *const cat_anim_deltas[5] = {
+  cat_both_0_delta,
+  cat_idle_0_delta,
+  cat_idle_1_delta,
+  cat_left_0_delta,
+  cat_right_0_delta,
+};
+
+static const sprite_anim_t cat_anim = {
+  .key = &cat_key_sprite,
+  .frames = 5,
+  .deltas = cat_anim_deltas,
+};
+
+static const uint8_t icon__0_sprite_bits[180] = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x10,
+  0x0c, 0x02, 0x04, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+  0x04, 0x02, 0x0c, 0x10, 0x20, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xc0, 0x30, 0x0e, 0x01, 0x00, 0x00, 0x06, 0x06,
+  0x00, 0x00, 0x08, 0x10, 0x10, 0x08, 0x10, 0x10, 0x08, 0x00, 0x00, 0x00,
+  0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x07, 0x18, 0x60, 0x00, 0x00, 0x00,
+  0x01, 0x01, 0x00, 0x07, 0x08, 0x08, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00,
+  0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00,
+  0x07, 0x08, 0x08, 0x08, 0x04, 0x02, 0x01, 0x00, 0x01, 0x01, 0x01, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const sprite_t icon__0_sprite = {
+  .width = 36,
+  .height = 36,
+  .rows = 5,
+  .shifts = 1,
+  .compressed = false,
+  .bits = icon__0_sprite_bits,
+};
@@ -1,4 +1,5 @@
 #include <ctype.h>
+#include <shared/anim.h>
 #include <shared/apps/apps.h>
 #include <shared/utils/elm.h>
 #include <shared/engine.h>
@@ -88,6 +89,9 @@ enum
   TARGET_MORSE_LENGTH = 5,
 };
 
+static const color_t LED_IDLE = {.hex = 0x00ff00};
+static const color_t LED_MARK = {.hex = 0xffffff};
+
 typedef struct
 {
   uint32_t T; // base time unit in ticks (adaptive)
@@ -95,6 +99,7 @@ typedef struct
   char target_morse[TARGET_MORSE_COUNT][TARGET_MORSE_LENGTH];
   const char *current_word;
   uint32_t current_letter;
+  color_t led; // lit while keying, fades back to green
 } state_t;
 
 static state_t *state;
@@ -131,7 +136,7 @@ static void _update_current_word()
 
 static void enter()
 {
-  state = calloc(1, sizeof(state_t));
+  state = engine_alloc(sizeof(state_t));
 
   // pick words
   for (uint32_t i = 0; i < WORD_LOOKAHEAD - 1; i++)
@@ -140,6 +145,7 @@ static void enter()
   }
   // prep first word
   _update_current_word();
+  state->led = LED_IDLE;
 
   // setup audio synth
   audio_synth_operator_config_t config = audio_synth_operator_config_default;
@@ -159,14 +165,17 @@ static void tick()
   {
     // begin mark
     // update T based on time since last keyup
+    anim_cancel(&state->led, false);
+    state->led = LED_MARK;
     audio_synth_enqueue(
         &g_engine.synth,
         &(audio_synth_message_t){
             .type = AUDIO_SYNTH_MESSAGE_NOTE_ON,
+            .time_us = (uint32_t)to_us_since_boot(g_engine.buttons.right.edge_at),
             .data.note_on =
                 {
                     .voice = 0,
-                    .note_number = note("C5"),
+                    .note_number = NOTE(C, 5),
                     .velocity = 100,
                 },
         });
@@ -175,6 +184,7 @@ static void tick()
   {
     // end mark
     // update T based on time since keydown
+    anim_color_to(&state->led, LED_IDLE, 200, EASE_OUT_QUAD, NULL, NULL);
     audio_synth_enqueue(
         &g_engine.synth,
         &(audio_synth_message_t){
@@ -270,12 +280,12 @@ static void frame()
   ctx = elm_child(&root, vec2(0, 20));
   _frame_target_morse(u8g2, &ctx);
 
-  leds_set_all(&g_engine.leds, (color_t){.hex = 0x00ff00});
+  leds_set_all(&g_engine.leds, state->led);
 }
 
 static void leave()
 {
-  free(state);
+  state = NULL; // engine_alloc() memory goes with the app
 }
 
 app_t app_morse = {
@@ -0,0 +1,89 @@
+#include <math.h>
+#include <string.h>
+
+#include "analysis.h"
+
+#define COEFF_SHIFT 14
+
+void audio_analysis_init(audio_analysis_t *analysis, uint32_t sample_rate) {
+  memset(analysis, 0, sizeof(*analysis));
+  for (int band = 0; band < AUDIO_ANALYSIS_BANDS; band++) {
+    float w = 2.f * (float)M_PI * AUDIO_ANALYSIS_BAND_HZ[band] / sample_rate;
+    analysis->coeff[band] = (int32_t)lroundf(2.f * cosf(w) * (1 << COEFF_SHIFT));
+  }
+  seqlock_init(&analysis->lock);
+}
+
+static uint32_t isqrt64(uint64_t value) {
+  uint64_t result = 0;
+  uint64_t bit = 1ull << 62;
+  while (bit > value)
+    bit >>= 2;
+  while (bit) {
+    if (value >= result + bit) {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)result;
+}
+
+static inline uint16_t clamp_level(uint32_t level) {
+  return level > INT16_MAX ? INT16_MAX : (uint16_t)level;
+}
+
+void audio_analysis_process(audio_analysis_t *analysis, const uint32_t *frames,
+                            uint32_t count) {
+  if (!analysis->enabled || count == 0)
+    return;
+
+  uint64_t sum_sq = 0;
+  uint32_t peak = 0;
+  int32_t s1[AUDIO_ANALYSIS_BANDS] = {0};
+  int32_t s2[AUDIO_ANALYSIS_BANDS] = {0};
+  for (uint32_t i = 0; i < count; i++) {
+    // output is mono, take the right channel
+    int32_t x = (int16_t)(frames[i] & 0xffff);
+    sum_sq += (uint32_t)(x * x);
+    uint32_t mag = x < 0 ? -x : x;
+    if (mag > peak)
+      peak = mag;
+
+    for (int band = 0; band < AUDIO_ANALYSIS_BANDS; band++) {
+      int32_t s0 = x +
+                   (int32_t)(((int64_t)analysis->coeff[band] * s1[band]) >>
+                             COEFF_SHIFT) -
+                   s2[band];
+      s2[band] = s1[band];
+      s1[band] = s0;
+    }
+  }
+
+  seqlock_write_begin(&analysis->lock);
+  audio_analysis_snapshot_t *s = &analysis->snapshot;
+  s->buffers++;
+  s->rms = clamp_level(isqrt64(sum_sq / count));
+  s->peak = clamp_level(peak);
+  for (int band = 0; band < AUDIO_ANALYSIS_BANDS; band++) {
+    // |X|^2 = s1^2 + s2^2 - coeff * s1 * s2, amplitude = 2|X| / N
+    int64_t a = s1[band], b = s2[band];
+    int64_t power =
+        a * a + b * b - ((analysis->coeff[band] * a) >> COEFF_SHIFT) * b;
+    uint32_t amplitude =
+        (uint32_t)((uint64_t)isqrt64(power > 0 ? power : 0) * 2 / count);
+    s->bands[band] = clamp_level(amplitude);
+  }
+  seqlock_write_end(&analysis->lock);
+}
+
+void audio_analysis_read(const audio_analysis_t *analysis,
+                         audio_analysis_snapshot_t *out) {
+  uint32_t seq;
+  do {
+    seq = seqlock_read_begin(&analysis->lock);
+    *out = analysis->snapshot;
+  } while (seqlock_read_retry(&analysis->lock, seq));
+}
@@ -0,0 +1,51 @@
+// Output level analysis for apps that react to sound.
+// When enabled, the audio core measures every rendered buffer (after master
+// level) and publishes RMS, peak and a few Goertzel band levels as a
+// snapshot that core0 can read without locking or copying audio.
+//
+// Band resolution follows the buffer length: with 128 samples at 48 kHz a
+// band is ~375 Hz wide, so the lowest band also catches neighbouring bass.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <shared/utils/seqlock.h>
+
+#define AUDIO_ANALYSIS_BANDS 4
+
+// band center frequencies in Hz, low to high
+static const uint16_t AUDIO_ANALYSIS_BAND_HZ[AUDIO_ANALYSIS_BANDS] = {
+    150, 600, 2400, 7200};
+
+typedef struct {
+  uint32_t buffers; // buffers analysed so far, changes when a new one lands
+  uint16_t rms;     // 0-32767
+  uint16_t peak;    // 0-32767
+  uint16_t bands[AUDIO_ANALYSIS_BANDS]; // sine amplitude at each band, 0-32767
+} audio_analysis_snapshot_t;
+
+typedef struct {
+  volatile bool enabled;
+  int32_t coeff[AUDIO_ANALYSIS_BANDS]; // 2cos(w) in q2.14
+
+  seqlock_t lock;
+  audio_analysis_snapshot_t snapshot;
+} audio_analysis_t;
+
+void audio_analysis_init(audio_analysis_t *analysis, uint32_t sample_rate);
+
+// enable or disable analysis (any core). disabling keeps the last snapshot.
+static inline void audio_analysis_set_enabled(audio_analysis_t *analysis,
+                                              bool enabled) {
+  analysis->enabled = enabled;
+}
+
+// measure one rendered buffer of output frames (audio core)
+void audio_analysis_process(audio_analysis_t *analysis, const uint32_t *frames,
+                            uint32_t count);
+
+// copy out the last published snapshot (any core)
+void audio_analysis_read(const audio_analysis_t *analysis,
+                         audio_analysis_snapshot_t *out);
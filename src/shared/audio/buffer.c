@@ -6,9 +6,9 @@
 
 #include "buffer.h"
 
-void audio_buffer_pool_init(audio_buffer_pool_t *pool, uint8_t size,
-                            uint32_t buffer_size) {
-  pool->buffers = malloc(size * buffer_size * sizeof(uint32_t));
+void audio_buffer_pool_init(audio_buffer_pool_t *pool, uint32_t *storage,
+                            uint8_t size, uint32_t buffer_size) {
+  pool->buffers = storage;
   pool->size = size;
   pool->buffer_size = buffer_size;
   pool->count = 0;
@@ -17,8 +17,6 @@ void audio_buffer_pool_init(audio_buffer_pool_t *pool, uint8_t size,
 }
 
 void audio_buffer_pool_free(audio_buffer_pool_t *pool) {
-  free(pool->buffers);
-
   pool->buffers = NULL;
 
   pool->size = 0;
@@ -19,8 +19,9 @@ typedef struct {
   uint8_t read_head;
 } audio_buffer_pool_t;
 
-void audio_buffer_pool_init(audio_buffer_pool_t *pool, uint8_t size,
-                            uint32_t buffer_size);
+// storage holds size * buffer_size samples and stays with the caller
+void audio_buffer_pool_init(audio_buffer_pool_t *pool, uint32_t *storage,
+                            uint8_t size, uint32_t buffer_size);
 void audio_buffer_pool_free(audio_buffer_pool_t *pool);
 uint32_t *audio_buffer_pool_acquire_write(audio_buffer_pool_t *pool,
                                           bool blocking);
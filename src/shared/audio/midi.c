@@ -0,0 +1,174 @@
+#include <string.h>
+
+#include "midi.h"
+
+// data bytes following a status byte
+static uint8_t data_length(uint8_t status) {
+  switch (status & 0xf0) {
+  case MIDI_PROGRAM_CHANGE:
+  case MIDI_CHANNEL_PRESSURE:
+    return 1;
+  case 0xf0:
+    break;
+  default:
+    return 2;
+  }
+  switch (status) {
+  case 0xf1: // time code quarter frame
+  case 0xf3: // song select
+    return 1;
+  case 0xf2: // song position
+    return 2;
+  default:
+    return 0;
+  }
+}
+
+void midi_parser_init(midi_parser_t *parser) {
+  memset(parser, 0, sizeof(*parser));
+}
+
+bool midi_parser_feed(midi_parser_t *parser, uint8_t byte,
+                      midi_message_t *out) {
+  if (byte >= 0xf8) {
+    // realtime, may appear anywhere
+    *out = (midi_message_t){.status = byte};
+    return true;
+  }
+
+  if (byte & 0x80) {
+    parser->sysex = byte == MIDI_SYSEX;
+    parser->count = 0;
+    // system common messages cancel running status
+    parser->status = byte < 0xf0 || data_length(byte) ? byte : 0;
+    if (byte >= 0xf0 && !parser->sysex && data_length(byte) == 0) {
+      *out = (midi_message_t){.status = byte};
+      return byte != MIDI_SYSEX_END;
+    }
+    return false;
+  }
+
+  if (parser->sysex || parser->status == 0)
+    return false;
+
+  parser->data[parser->count++] = byte;
+  if (parser->count < data_length(parser->status))
+    return false;
+
+  out->status = parser->status;
+  out->data[0] = parser->data[0];
+  out->data[1] = parser->count > 1 ? parser->data[1] : 0;
+  parser->count = 0;
+  if (parser->status >= 0xf0)
+    parser->status = 0; // no running status for system common
+  return true;
+}
+
+void audio_synth_midi_init(audio_synth_midi_t *midi, audio_synth_t *synth,
+                           uint8_t first_voice, uint8_t voice_count) {
+  memset(midi, 0, sizeof(*midi));
+  midi->synth = synth;
+  midi->first_voice = first_voice;
+  midi->voice_count = voice_count;
+  memset(midi->note, MIDI_VOICE_FREE, sizeof(midi->note));
+  midi_parser_init(&midi->parser);
+}
+
+static void send(audio_synth_midi_t *midi, audio_synth_message_t *msg) {
+  if (!audio_synth_enqueue(midi->synth, msg))
+    midi->dropped++;
+}
+
+static void release(audio_synth_midi_t *midi, uint8_t voice,
+                    uint32_t time_us) {
+  midi->note[voice] = MIDI_VOICE_FREE;
+  midi->age[voice] = midi->clock++;
+  send(midi, &(audio_synth_message_t){
+                 .type = AUDIO_SYNTH_MESSAGE_NOTE_OFF,
+                 .time_us = time_us,
+                 .data.note_off = {.voice = midi->first_voice + voice},
+             });
+}
+
+// prefer the free voice released longest ago, otherwise steal the oldest note
+static uint8_t allocate(audio_synth_midi_t *midi) {
+  uint8_t best = 0;
+  bool best_free = false;
+  for (uint8_t i = 0; i < midi->voice_count; i++) {
+    bool free = midi->note[i] == MIDI_VOICE_FREE;
+    if ((free && !best_free) ||
+        (free == best_free && midi->age[i] < midi->age[best])) {
+      best = i;
+      best_free = free;
+    }
+  }
+  return best;
+}
+
+static void note_on(audio_synth_midi_t *midi, uint8_t channel, uint8_t note,
+                    uint8_t velocity, uint32_t time_us) {
+  // retrigger a held note on the voice it already owns
+  uint8_t voice = midi->voice_count;
+  for (uint8_t i = 0; i < midi->voice_count; i++)
+    if (midi->note[i] == note && midi->channel[i] == channel)
+      voice = i;
+  if (voice == midi->voice_count)
+    voice = allocate(midi);
+
+  midi->channel[voice] = channel;
+  midi->note[voice] = note;
+  midi->age[voice] = midi->clock++;
+  send(midi, &(audio_synth_message_t){
+                 .type = AUDIO_SYNTH_MESSAGE_NOTE_ON,
+                 .time_us = time_us,
+                 .data.note_on = {.voice = midi->first_voice + voice,
+                                  .note_number = note,
+                                  .velocity = velocity},
+             });
+}
+
+static void note_off(audio_synth_midi_t *midi, uint8_t channel, uint8_t note,
+                     uint32_t time_us) {
+  for (uint8_t i = 0; i < midi->voice_count; i++)
+    if (midi->note[i] == note && midi->channel[i] == channel)
+      release(midi, i, time_us);
+}
+
+void audio_synth_midi_message(audio_synth_midi_t *midi,
+                              const midi_message_t *msg, uint32_t time_us) {
+  if (msg->status >= 0xf0 || midi->voice_count == 0)
+    return; // system messages have no effect on the synth
+  midi->messages++;
+
+  uint8_t channel = msg->status & 0x0f;
+  switch (msg->status & 0xf0) {
+  case MIDI_NOTE_ON:
+    if (msg->data[1] > 0) {
+      note_on(midi, channel, msg->data[0], msg->data[1], time_us);
+      break;
+    }
+    // velocity 0 is a note off
+    // fallthrough
+  case MIDI_NOTE_OFF:
+    note_off(midi, channel, msg->data[0], time_us);
+    break;
+  case MIDI_CONTROL_CHANGE:
+    if (msg->data[0] == MIDI_CC_ALL_SOUND_OFF ||
+        msg->data[0] == MIDI_CC_ALL_NOTES_OFF) {
+      for (uint8_t i = 0; i < midi->voice_count; i++)
+        if (midi->note[i] != MIDI_VOICE_FREE && midi->channel[i] == channel)
+          release(midi, i, time_us);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+void audio_synth_midi_feed(audio_synth_midi_t *midi, const uint8_t *bytes,
+                           size_t len, uint32_t time_us) {
+  midi_message_t msg;
+  for (size_t i = 0; i < len; i++)
+    if (midi_parser_feed(&midi->parser, bytes[i], &msg))
+      audio_synth_midi_message(midi, &msg, time_us);
+}
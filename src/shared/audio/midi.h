@@ -0,0 +1,80 @@
+// MIDI byte stream input for the synth.
+//
+// midi_parser_t turns a raw MIDI byte stream into messages (running status,
+// interleaved realtime bytes and sysex are handled). audio_synth_midi_t sits
+// on top of it, allocates synth voices for incoming notes and queues
+// note on/off messages with their arrival time, so the synth can record the
+// input -> render latency (see stats.h).
+//
+// Feeding is done from a single context (a thread on host, the USB stdio
+// callback on device); only audio_synth_enqueue crosses to the audio core.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "synth.h"
+
+#define MIDI_NOTE_OFF 0x80
+#define MIDI_NOTE_ON 0x90
+#define MIDI_POLY_PRESSURE 0xa0
+#define MIDI_CONTROL_CHANGE 0xb0
+#define MIDI_PROGRAM_CHANGE 0xc0
+#define MIDI_CHANNEL_PRESSURE 0xd0
+#define MIDI_PITCH_BEND 0xe0
+#define MIDI_SYSEX 0xf0
+#define MIDI_SYSEX_END 0xf7
+
+#define MIDI_CC_ALL_SOUND_OFF 120
+#define MIDI_CC_ALL_NOTES_OFF 123
+
+#define MIDI_VOICE_FREE 0xff
+
+typedef struct {
+  uint8_t status; // status byte including channel
+  uint8_t data[2];
+} midi_message_t;
+
+typedef struct {
+  uint8_t status; // running status, 0 if none
+  uint8_t data[2];
+  uint8_t count;  // data bytes received for the current message
+  bool sysex;     // inside a sysex message, skipping data
+} midi_parser_t;
+
+typedef struct {
+  audio_synth_t *synth;
+  midi_parser_t parser;
+
+  // voices [first_voice, first_voice + voice_count) are used for MIDI notes
+  uint8_t first_voice;
+  uint8_t voice_count;
+  uint8_t channel[AUDIO_SYNTH_VOICE_COUNT]; // channel holding each voice
+  uint8_t note[AUDIO_SYNTH_VOICE_COUNT];    // held note, MIDI_VOICE_FREE if none
+  uint32_t age[AUDIO_SYNTH_VOICE_COUNT];    // clock of the last note on/off
+  uint32_t clock;
+
+  uint32_t messages; // channel messages parsed
+  uint32_t dropped;  // synth messages lost to a full queue
+} audio_synth_midi_t;
+
+void midi_parser_init(midi_parser_t *parser);
+
+// feed one byte, returns true and fills `out` when a message is complete.
+// realtime messages (0xf8-0xff) are returned as-is without disturbing the
+// message they interrupt. sysex contents are skipped.
+bool midi_parser_feed(midi_parser_t *parser, uint8_t byte,
+                      midi_message_t *out);
+
+void audio_synth_midi_init(audio_synth_midi_t *midi, audio_synth_t *synth,
+                           uint8_t first_voice, uint8_t voice_count);
+
+// parse a chunk of bytes that arrived at `time_us` (time_us_32)
+void audio_synth_midi_feed(audio_synth_midi_t *midi, const uint8_t *bytes,
+                           size_t len, uint32_t time_us);
+
+// play an already parsed message (e.g. from a MIDI file)
+void audio_synth_midi_message(audio_synth_midi_t *midi,
+                              const midi_message_t *msg, uint32_t time_us);
@@ -0,0 +1,256 @@
+#include <string.h>
+
+#include "sequencer.h"
+
+static const uint8_t RESTART_NONE = 0xff;
+
+static void update_row_length(audio_synth_t *synth)
+{
+  audio_synth_sequencer_t *seq = &synth->sequencer;
+  uint32_t rows_per_minute = (uint32_t)seq->bpm * seq->rows_per_beat;
+  if (rows_per_minute == 0)
+    rows_per_minute = 1;
+  uint64_t samples_per_minute = (uint64_t)synth->sample_rate * 60;
+  seq->row_q8 = (uint32_t)((samples_per_minute << 8) / rows_per_minute);
+}
+
+// skip over one packed row without playing it
+static const uint8_t *skip_row(const uint8_t *p)
+{
+  uint8_t mask = *p++;
+  for (; mask; mask >>= 1)
+  {
+    if (!(mask & 1))
+      continue;
+    uint8_t flags = *p++;
+    if (flags & AUDIO_SEQ_CELL_NOTE)
+      p++;
+    if (flags & AUDIO_SEQ_CELL_INSTRUMENT)
+      p++;
+    if (flags & AUDIO_SEQ_CELL_EFFECT)
+      p += 2;
+  }
+  return p;
+}
+
+// move to a position in the order list. past the end the song restarts or
+// stops.
+static void start_order(audio_synth_t *synth, uint8_t order, uint8_t row)
+{
+  audio_synth_sequencer_t *seq = &synth->sequencer;
+  const audio_synth_song_t *song = seq->song;
+  if (order >= song->order_count)
+  {
+    if (song->restart == RESTART_NONE || song->restart >= song->order_count)
+    {
+      audio_synth_sequencer_stop(synth);
+      return;
+    }
+    order = song->restart;
+  }
+
+  const uint8_t *pattern = song->patterns[song->order[order]];
+  seq->order = order;
+  seq->row_count = pattern[0];
+  seq->next = pattern + 1;
+  for (seq->row = 0; seq->row < row && seq->row < seq->row_count; seq->row++)
+    seq->next = skip_row(seq->next);
+}
+
+static void apply_effect(audio_synth_t *synth, uint8_t channel, uint8_t effect,
+                         uint8_t param)
+{
+  audio_synth_sequencer_t *seq = &synth->sequencer;
+  switch (effect)
+  {
+  case AUDIO_SEQ_FX_TEMPO:
+    seq->bpm = param;
+    update_row_length(synth);
+    break;
+  case AUDIO_SEQ_FX_SPEED:
+    seq->rows_per_beat = param;
+    update_row_length(synth);
+    break;
+  case AUDIO_SEQ_FX_SWING:
+    seq->swing = param;
+    break;
+  case AUDIO_SEQ_FX_VELOCITY:
+    seq->velocity[channel] = param > 127 ? 127 : param;
+    break;
+  case AUDIO_SEQ_FX_JUMP:
+    seq->jump = true;
+    seq->jump_order = param;
+    seq->jump_row = 0;
+    break;
+  case AUDIO_SEQ_FX_BREAK:
+    seq->jump = true;
+    seq->jump_order = seq->order + 1;
+    seq->jump_row = param;
+    break;
+  case AUDIO_SEQ_FX_STOP:
+    seq->stop = true;
+    break;
+  }
+}
+
+static void play_row(audio_synth_t *synth)
+{
+  audio_synth_sequencer_t *seq = &synth->sequencer;
+  const audio_synth_song_t *song = seq->song;
+
+  const uint8_t *p = seq->next;
+  uint8_t mask = *p++;
+  for (uint8_t channel = 0; mask; channel++, mask >>= 1)
+  {
+    if (!(mask & 1))
+      continue;
+
+    uint8_t flags = *p++;
+    uint8_t note = 0, instrument = 0, effect = 0, param = 0;
+    if (flags & AUDIO_SEQ_CELL_NOTE)
+      note = *p++;
+    if (flags & AUDIO_SEQ_CELL_INSTRUMENT)
+      instrument = *p++;
+    if (flags & AUDIO_SEQ_CELL_EFFECT)
+    {
+      effect = *p++;
+      param = *p++;
+    }
+
+    uint8_t voice_idx = seq->voice + channel;
+    if (channel >= song->channels || voice_idx >= AUDIO_SYNTH_VOICE_COUNT)
+      continue;
+    audio_synth_voice_t *voice = &synth->voices[voice_idx];
+
+    if ((flags & AUDIO_SEQ_CELL_INSTRUMENT) &&
+        instrument < song->instrument_count)
+    {
+      const audio_synth_instrument_t *inst = &song->instruments[instrument];
+      for (int op_idx = 0; op_idx < AUDIO_SYNTH_OPERATOR_COUNT; op_idx++)
+        audio_synth_operator_apply_config(&voice->ops[op_idx],
+                                          inst->ops[op_idx]);
+    }
+
+    if (flags & AUDIO_SEQ_CELL_EFFECT)
+      apply_effect(synth, channel, effect, param);
+
+    if (flags & AUDIO_SEQ_CELL_NOTE)
+    {
+      if (note == AUDIO_SEQ_NOTE_OFF)
+        audio_synth_voice_note_off(voice);
+      else
+        audio_synth_voice_note_on(voice, note & 0x7f,
+                                  seq->velocity[channel]);
+    }
+  }
+  seq->next = p;
+  bool odd = seq->row & 1;
+  seq->row++;
+
+  // schedule the next row. swing stretches even rows and shrinks odd rows by
+  // the same amount, the remainder carries over so tempo never drifts.
+  uint64_t length_q8 = seq->row_q8;
+  if (seq->swing)
+  {
+    uint32_t scale = odd ? 256 - seq->swing : 256 + seq->swing;
+    length_q8 = (length_q8 * scale) >> 8;
+  }
+  length_q8 += seq->frac_q8;
+  seq->countdown = (uint32_t)(length_q8 >> 8);
+  seq->frac_q8 = (uint32_t)(length_q8 & 0xff);
+  if (seq->countdown == 0)
+    seq->countdown = 1;
+}
+
+static void next_row(audio_synth_t *synth)
+{
+  audio_synth_sequencer_t *seq = &synth->sequencer;
+  if (seq->stop)
+  {
+    audio_synth_sequencer_stop(synth);
+    return;
+  }
+  if (seq->jump)
+  {
+    seq->jump = false;
+    start_order(synth, seq->jump_order, seq->jump_row);
+  }
+  // past the end of the pattern, also after a break past its rows or into an
+  // empty pattern: on to the next order. a song of only empty patterns stops
+  // once every order was tried.
+  for (uint16_t tries = 0; seq->song != NULL && seq->row >= seq->row_count;
+       tries++)
+  {
+    if (tries > seq->song->order_count)
+    {
+      audio_synth_sequencer_stop(synth);
+      return;
+    }
+    start_order(synth, seq->order + 1, 0);
+  }
+  if (seq->song == NULL)
+    return; // reached the end
+  play_row(synth);
+}
+
+void audio_synth_sequencer_play(audio_synth_t *synth,
+                                const audio_synth_song_t *song, uint8_t voice)
+{
+  audio_synth_sequencer_stop(synth);
+  if (song == NULL || song->order_count == 0)
+    return;
+
+  audio_synth_sequencer_t *seq = &synth->sequencer;
+  seq->song = song;
+  seq->voice = voice;
+  seq->bpm = song->bpm;
+  seq->rows_per_beat = song->rows_per_beat;
+  seq->swing = song->swing;
+  update_row_length(synth);
+
+  seq->jump = false;
+  seq->stop = false;
+  seq->countdown = 0; // first row plays immediately
+  seq->frac_q8 = 0;
+  memset(seq->velocity, AUDIO_SEQ_DEFAULT_VELOCITY, sizeof(seq->velocity));
+
+  start_order(synth, 0, 0);
+}
+
+void audio_synth_sequencer_stop(audio_synth_t *synth)
+{
+  audio_synth_sequencer_t *seq = &synth->sequencer;
+  const audio_synth_song_t *song = seq->song;
+  if (song == NULL)
+    return;
+  for (uint8_t channel = 0; channel < song->channels; channel++)
+  {
+    uint8_t voice_idx = seq->voice + channel;
+    if (voice_idx < AUDIO_SYNTH_VOICE_COUNT)
+      audio_synth_voice_note_off(&synth->voices[voice_idx]);
+  }
+  seq->song = NULL;
+}
+
+uint32_t audio_synth_sequencer_update(audio_synth_t *synth)
+{
+  audio_synth_sequencer_t *seq = &synth->sequencer;
+  if (seq->song == NULL)
+    return UINT32_MAX;
+
+  if (seq->countdown == 0)
+  {
+    next_row(synth);
+    if (seq->song == NULL)
+      return UINT32_MAX;
+  }
+  return seq->countdown;
+}
+
+void audio_synth_sequencer_advance(audio_synth_t *synth, uint32_t samples)
+{
+  audio_synth_sequencer_t *seq = &synth->sequencer;
+  if (seq->song == NULL)
+    return;
+  seq->countdown -= samples;
+}
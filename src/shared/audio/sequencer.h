@@ -0,0 +1,73 @@
+// Tracker-style pattern sequencer, run by the synth on the audio core.
+//
+// Songs are const data in flash (see audio_synth_song_t). Each pattern is a
+// packed byte stream:
+//
+//   u8 row_count
+//   row_count rows of:
+//     u8 channel_mask     bit n set = channel n has a cell on this row
+//     one cell per set bit, lowest channel first:
+//       u8 flags          AUDIO_SEQ_CELL_*
+//       [u8 note]         MIDI note, or AUDIO_SEQ_NOTE_OFF
+//       [u8 instrument]   index into song->instruments
+//       [u8 effect]       audio_synth_seq_effect_t
+//       [u8 param]        effect parameter
+//
+// An empty row is a single 0x00 byte. Channel n plays on synth voice
+// (voice + n), where voice is given when the song is started. Rows advance on
+// exact sample boundaries; row length is 60 / (bpm * rows_per_beat) seconds,
+// with swing lengthening even rows and shortening odd rows by swing/256 so
+// each pair keeps its length (swing 85 is roughly a triplet shuffle).
+
+#pragma once
+
+#include <assert.h>
+#include <stdint.h>
+
+#include "synth.h"
+
+#define AUDIO_SEQ_NOTE_OFF 0x80
+#define AUDIO_SEQ_DEFAULT_VELOCITY 100
+
+enum
+{
+  AUDIO_SEQ_CELL_NOTE = 1 << 0,
+  AUDIO_SEQ_CELL_INSTRUMENT = 1 << 1,
+  AUDIO_SEQ_CELL_EFFECT = 1 << 2,
+};
+
+typedef enum
+{
+  AUDIO_SEQ_FX_NONE = 0,
+  AUDIO_SEQ_FX_TEMPO,    // set bpm to param
+  AUDIO_SEQ_FX_SPEED,    // set rows per beat to param
+  AUDIO_SEQ_FX_SWING,    // set swing to param
+  AUDIO_SEQ_FX_VELOCITY, // set channel velocity (0-127), from this row on
+  AUDIO_SEQ_FX_JUMP,     // after this row, continue at order position param
+  AUDIO_SEQ_FX_BREAK,    // after this row, go to row param of the next order
+  AUDIO_SEQ_FX_STOP,     // stop the song after this row
+} audio_synth_seq_effect_t;
+
+// helpers for writing patterns by hand
+#define AUDIO_SEQ_NOTE(n) AUDIO_SEQ_CELL_NOTE, (n)
+#define AUDIO_SEQ_NOTE_INST(n, i)                                              \
+  AUDIO_SEQ_CELL_NOTE | AUDIO_SEQ_CELL_INSTRUMENT, (n), (i)
+#define AUDIO_SEQ_FX(fx, param) AUDIO_SEQ_CELL_EFFECT, (fx), (param)
+
+static_assert(AUDIO_SYNTH_VOICE_COUNT <= 8,
+              "sequencer channel masks are 8 bits wide");
+
+// start playing a song from the top (internal, audio core only)
+void audio_synth_sequencer_play(audio_synth_t *synth,
+                                const audio_synth_song_t *song, uint8_t voice);
+
+// stop the song and release its voices (internal, audio core only)
+void audio_synth_sequencer_stop(audio_synth_t *synth);
+
+// play any rows due now and return the samples until the next row, or
+// UINT32_MAX when stopped (internal, audio core only)
+uint32_t audio_synth_sequencer_update(audio_synth_t *synth);
+
+// account for rendered samples, never more than the last update() returned
+// (internal, audio core only)
+void audio_synth_sequencer_advance(audio_synth_t *synth, uint32_t samples);
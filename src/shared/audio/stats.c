@@ -0,0 +1,84 @@
+#include <string.h>
+
+#include "stats.h"
+
+audio_stats_t g_audio_stats;
+
+void audio_stats_init(audio_stats_t *stats, uint32_t sample_rate,
+                      uint32_t buffer_size) {
+  memset(stats, 0, sizeof(*stats));
+  stats->budget_us = (uint32_t)((uint64_t)buffer_size * 1000000 / sample_rate);
+  stats->window_len = sample_rate / buffer_size;
+  if (stats->window_len == 0)
+    stats->window_len = 1;
+  seqlock_init(&stats->lock);
+  stats->snapshot.budget_us = stats->budget_us;
+}
+
+static inline uint16_t load_pct(const audio_stats_t *stats, uint32_t us) {
+  uint32_t pct = us * 100 / stats->budget_us;
+  return pct > UINT16_MAX ? UINT16_MAX : (uint16_t)pct;
+}
+
+static uint16_t hist_percentile(const audio_stats_t *stats, uint32_t permille) {
+  uint32_t target = (stats->count * permille + 999) / 1000;
+  uint32_t seen = 0;
+  for (int i = 0; i < AUDIO_STATS_HIST_BUCKETS; i++) {
+    seen += stats->hist[i];
+    if (seen >= target)
+      return (i + 1) * AUDIO_STATS_HIST_STEP;
+  }
+  return AUDIO_STATS_HIST_BUCKETS * AUDIO_STATS_HIST_STEP;
+}
+
+static void publish(audio_stats_t *stats) {
+  seqlock_write_begin(&stats->lock);
+  audio_stats_snapshot_t *s = &stats->snapshot;
+  s->budget_us = stats->budget_us;
+  s->buffers = stats->count;
+  s->avg_us = stats->sum_us / stats->count;
+  s->peak_us = stats->peak_us;
+  s->avg_load = load_pct(stats, s->avg_us);
+  s->peak_load = load_pct(stats, s->peak_us);
+  s->p99_load = hist_percentile(stats, 990);
+  s->overruns = stats->overruns;
+  s->underruns = stats->underruns;
+  s->notes = stats->notes;
+  s->note_avg_us = stats->notes ? stats->note_sum_us / stats->notes : 0;
+  s->note_peak_us = stats->note_peak_us;
+  seqlock_write_end(&stats->lock);
+
+  // start next window
+  stats->count = 0;
+  stats->sum_us = 0;
+  stats->peak_us = 0;
+  memset(stats->hist, 0, sizeof(stats->hist));
+  stats->notes = 0;
+  stats->note_sum_us = 0;
+  stats->note_peak_us = 0;
+}
+
+void audio_stats_record(audio_stats_t *stats, uint32_t render_us) {
+  stats->count++;
+  stats->sum_us += render_us;
+  if (render_us > stats->peak_us)
+    stats->peak_us = render_us;
+  if (render_us > stats->budget_us)
+    stats->overruns++;
+
+  uint32_t bucket = load_pct(stats, render_us) / AUDIO_STATS_HIST_STEP;
+  if (bucket >= AUDIO_STATS_HIST_BUCKETS)
+    bucket = AUDIO_STATS_HIST_BUCKETS - 1;
+  stats->hist[bucket]++;
+
+  if (stats->count >= stats->window_len)
+    publish(stats);
+}
+
+void audio_stats_read(const audio_stats_t *stats, audio_stats_snapshot_t *out) {
+  uint32_t seq;
+  do {
+    seq = seqlock_read_begin(&stats->lock);
+    *out = stats->snapshot;
+  } while (seqlock_read_retry(&stats->lock, seq));
+}
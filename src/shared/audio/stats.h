@@ -0,0 +1,81 @@
+// Audio render deadline monitor.
+// The audio core records how long each buffer took to render against the
+// buffer period, and the playback backend counts underruns (buffers where
+// output fell back to silence). Timestamped note-ons (e.g. from MIDI input)
+// also record their latency from input arrival until the synth starts
+// rendering them; the output buffer queue adds its depth on top of that.
+// Once per window the stats are published as a snapshot that core0 can read
+// without locking.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <shared/utils/seqlock.h>
+
+// load histogram used for percentiles. each bucket covers
+// AUDIO_STATS_HIST_STEP percent of the budget, the last one catches the rest.
+#define AUDIO_STATS_HIST_BUCKETS 64
+#define AUDIO_STATS_HIST_STEP 4
+
+typedef struct {
+  uint32_t budget_us; // buffer period, i.e. the render deadline
+  uint32_t buffers;   // buffers rendered in the last window
+  uint32_t avg_us;    // average render time in the last window
+  uint32_t peak_us;   // worst render time in the last window
+  uint16_t avg_load;  // average render time in % of budget
+  uint16_t peak_load; // worst render time in % of budget
+  uint16_t p99_load;  // 99th percentile in % of budget (bucket upper bound)
+  uint32_t overruns;  // total buffers that rendered slower than budget
+  uint32_t underruns; // total buffers the output had to replace with silence
+  uint32_t notes;        // timestamped note-ons in the last window
+  uint32_t note_avg_us;  // average input -> render latency of those notes
+  uint32_t note_peak_us; // worst input -> render latency of those notes
+} audio_stats_snapshot_t;
+
+typedef struct {
+  uint32_t budget_us;
+  uint32_t window_len; // buffers per published snapshot (~1 second)
+
+  // window accumulators, only touched by the audio core
+  uint32_t count;
+  uint32_t sum_us;
+  uint32_t peak_us;
+  uint32_t overruns;
+  uint16_t hist[AUDIO_STATS_HIST_BUCKETS];
+  uint32_t notes;
+  uint32_t note_sum_us;
+  uint32_t note_peak_us;
+
+  // written from the playback IRQ / callback
+  volatile uint32_t underruns;
+
+  seqlock_t lock;
+  audio_stats_snapshot_t snapshot;
+} audio_stats_t;
+
+extern audio_stats_t g_audio_stats;
+
+void audio_stats_init(audio_stats_t *stats, uint32_t sample_rate,
+                      uint32_t buffer_size);
+
+// record the render time of one buffer (audio core)
+void audio_stats_record(audio_stats_t *stats, uint32_t render_us);
+
+// record the input -> render latency of a timestamped note-on (audio core)
+static inline void audio_stats_note_latency(audio_stats_t *stats,
+                                            uint32_t latency_us) {
+  stats->notes++;
+  stats->note_sum_us += latency_us;
+  if (latency_us > stats->note_peak_us)
+    stats->note_peak_us = latency_us;
+}
+
+// count a buffer that the output had to replace with silence (playback IRQ)
+static inline void audio_stats_underrun(audio_stats_t *stats) {
+  stats->underruns = stats->underruns + 1;
+}
+
+// copy out the last published snapshot (any core)
+void audio_stats_read(const audio_stats_t *stats, audio_stats_snapshot_t *out);
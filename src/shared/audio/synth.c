@@ -4,12 +4,16 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <pico/time.h>
 #include <pico/util/queue.h>
 #include <shared/utils/q1x15.h>
 #include <shared/utils/q1x31.h>
 
 #include "buffer.h"
+#include "sequencer.h"
+#include "stats.h"
 #include "synth.h"
+#include "tune.h"
 
 static inline uint32_t lut_key(uint32_t phase)
 {
@@ -76,6 +80,10 @@ void audio_synth_init(audio_synth_t *synth, float sample_rate,
     }
   }
 
+  memset(&synth->sequencer, 0, sizeof(synth->sequencer));
+  memset(&synth->tune_player, 0, sizeof(synth->tune_player));
+  audio_analysis_init(&synth->analysis, (uint32_t)sample_rate);
+
   queue_init(&synth->msg_queue, sizeof(audio_synth_message_t),
              AUDIO_SYNTH_MESSAGE_QUEUE_SIZE);
   mutex_init(&synth->mutex);
@@ -102,11 +110,9 @@ static void make_env_stage_from_cfg(audio_synth_env_state_stage_t *stage,
 }
 
 // update operator values based on active config
-void audio_synth_operator_set_config(audio_synth_operator_t *op,
-                                     audio_synth_operator_config_t config)
+void audio_synth_operator_apply_config(audio_synth_operator_t *op,
+                                       audio_synth_operator_config_t config)
 {
-  mutex_t *mutex = &op->voice->synth->mutex;
-  mutex_enter_blocking(mutex);
   op->config = config;
 
   // update envelope timing
@@ -119,7 +125,14 @@ void audio_synth_operator_set_config(audio_synth_operator_t *op,
                           config.env.s);
   make_env_stage_from_cfg(&op->env.stages[3], d_timebase, config.env.r,
                           config.env.s, Q1X31_ZERO);
+}
 
+void audio_synth_operator_set_config(audio_synth_operator_t *op,
+                                     audio_synth_operator_config_t config)
+{
+  mutex_t *mutex = &op->voice->synth->mutex;
+  mutex_enter_blocking(mutex);
+  audio_synth_operator_apply_config(op, config);
   mutex_exit(mutex);
 }
 
@@ -300,6 +313,22 @@ static inline void _merge_drafts(q1x15 *out, q1x15 *in, uint32_t buffer_size)
   }
 }
 
+static void _render_voices(audio_synth_t *synth, audio_buffer_t buffer,
+                           q1x15 *draft_voice, uint32_t count)
+{
+  for (uint8_t voice_idx = 0; voice_idx < AUDIO_SYNTH_VOICE_COUNT;
+       voice_idx++)
+  {
+    audio_synth_voice_fill_buffer(&synth->voices[voice_idx], draft_voice,
+                                  count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+      q1x15 sample = draft_voice[i];
+      buffer[i] += (int32_t)sample;
+    }
+  }
+}
+
 static inline q1x15 soft_limit_q17x15(int32_t x)
 {
   // take a q17.15 sample and apply soft clipping to bring it back to q1x15
@@ -323,34 +352,29 @@ void audio_synth_fill_buffer(audio_synth_t *synth, audio_buffer_t buffer,
     audio_synth_handle_message(synth, &msg);
   }
 
-  static q1x15 *draft_voice = NULL;
-  static uint32_t draft_size = 0;
-  if (draft_size < buffer_size)
-  {
-    if (draft_voice == NULL)
-    {
-      draft_voice = malloc(buffer_size * sizeof(q1x15));
-    }
-    else
-    {
-      draft_voice = realloc(draft_voice, buffer_size * sizeof(q1x15));
-    }
-    draft_size = buffer_size;
-  }
+  static q1x15 draft_voice[AUDIO_SYNTH_MAX_SEGMENT];
 
   // misuse 32bit buffer as a 16bit mono buffer with room for overflow (so we
   // can clip later)
   memset(buffer, 0, buffer_size * sizeof(int32_t));
-  for (uint8_t voice_idx = 0; voice_idx < AUDIO_SYNTH_VOICE_COUNT;
-       voice_idx++)
+
+  // render in segments split at sequencer rows and tune events so notes land
+  // on the exact sample. with nothing playing this is a single segment.
+  uint32_t offset = 0;
+  while (offset < buffer_size)
   {
-    audio_synth_voice_fill_buffer(&synth->voices[voice_idx], draft_voice,
-                                  buffer_size);
-    for (uint32_t i = 0; i < buffer_size; i++)
-    {
-      q1x15 sample = draft_voice[i];
-      buffer[i] += (int32_t)sample;
-    }
+    uint32_t count = MIN(buffer_size - offset, AUDIO_SYNTH_MAX_SEGMENT);
+    uint32_t until = audio_synth_sequencer_update(synth);
+    if (until < count)
+      count = until;
+    until = audio_synth_tune_update(synth);
+    if (until < count)
+      count = until;
+
+    _render_voices(synth, buffer + offset, draft_voice, count);
+    audio_synth_sequencer_advance(synth, count);
+    audio_synth_tune_advance(synth, count);
+    offset += count;
   }
 
   // apply master level and write to output
@@ -366,6 +390,8 @@ void audio_synth_fill_buffer(audio_synth_t *synth, audio_buffer_t buffer,
   }
 
   mutex_exit(&synth->mutex);
+
+  audio_analysis_process(&synth->analysis, buffer, buffer_size);
 }
 
 void audio_synth_panic(audio_synth_t *synth)
@@ -377,6 +403,10 @@ void audio_synth_panic(audio_synth_t *synth)
     // do nothing, just dequeue
   }
 
+  // background music belongs to whoever started it
+  synth->sequencer.song = NULL;
+  synth->tune_player.tune = NULL;
+
   for (int voice_idx = 0; voice_idx < AUDIO_SYNTH_VOICE_COUNT; voice_idx++)
   {
     audio_synth_voice_panic(&synth->voices[voice_idx]);
@@ -394,6 +424,8 @@ void audio_synth_handle_message(audio_synth_t *synth,
     audio_synth_voice_note_on(&synth->voices[msg->data.note_on.voice],
                               msg->data.note_on.note_number,
                               msg->data.note_on.velocity);
+    if (msg->time_us)
+      audio_stats_note_latency(&g_audio_stats, time_us_32() - msg->time_us);
     break;
   }
   case AUDIO_SYNTH_MESSAGE_NOTE_OFF:
@@ -407,12 +439,34 @@ void audio_synth_handle_message(audio_synth_t *synth,
     audio_synth_panic(synth);
     break;
   }
+  case AUDIO_SYNTH_MESSAGE_SONG_PLAY:
+  {
+    audio_synth_sequencer_play(synth, msg->data.song_play.song,
+                               msg->data.song_play.voice);
+    break;
+  }
+  case AUDIO_SYNTH_MESSAGE_SONG_STOP:
+  {
+    audio_synth_sequencer_stop(synth);
+    break;
+  }
+  case AUDIO_SYNTH_MESSAGE_TUNE_PLAY:
+  {
+    audio_synth_tune_play(synth, msg->data.tune_play.tune,
+                          msg->data.tune_play.voice);
+    break;
+  }
+  case AUDIO_SYNTH_MESSAGE_TUNE_STOP:
+  {
+    audio_synth_tune_stop(synth);
+    break;
+  }
   }
 }
 
-void audio_synth_enqueue(audio_synth_t *synth, audio_synth_message_t *msg)
+bool audio_synth_enqueue(audio_synth_t *synth, audio_synth_message_t *msg)
 {
-  queue_try_add(&synth->msg_queue, msg);
+  return queue_try_add(&synth->msg_queue, msg);
 }
 
 void audio_synth_reset_voices(audio_synth_t *synth)
@@ -18,6 +18,7 @@
 #include <shared/utils/q1x15.h>
 #include <shared/utils/q1x31.h>
 
+#include "analysis.h"
 #include "buffer.h"
 
 #define AUDIO_SYNTH_VOICE_COUNT 8
@@ -25,15 +26,23 @@
 #define AUDIO_SYNTH_LUT_RES 10
 #define AUDIO_SYNTH_LUT_SIZE (1 << AUDIO_SYNTH_LUT_RES)
 #define AUDIO_SYNTH_MESSAGE_QUEUE_SIZE 32
+// longest stretch rendered in one go, larger buffers are split
+#define AUDIO_SYNTH_MAX_SEGMENT 512
 
 typedef struct audio_synth_t audio_synth_t;
 typedef struct audio_synth_voice_t audio_synth_voice_t;
+typedef struct audio_synth_song_t audio_synth_song_t;
+typedef struct audio_synth_tune_t audio_synth_tune_t;
 
 typedef enum
 {
   AUDIO_SYNTH_MESSAGE_NOTE_ON,  // play a note on a voice
   AUDIO_SYNTH_MESSAGE_NOTE_OFF, // release a voice
   AUDIO_SYNTH_MESSAGE_PANIC,    // stop all voices
+  AUDIO_SYNTH_MESSAGE_SONG_PLAY, // start a song on the sequencer
+  AUDIO_SYNTH_MESSAGE_SONG_STOP, // stop the sequencer and release its voices
+  AUDIO_SYNTH_MESSAGE_TUNE_PLAY, // start a baked event-stream tune
+  AUDIO_SYNTH_MESSAGE_TUNE_STOP, // stop the tune and release its voices
 } audio_synth_message_type_t;
 
 typedef struct audio_synth_message_note_on_t
@@ -52,14 +61,30 @@ typedef struct audio_synth_message_panic_t
 {
   // no data for panic
 } audio_synth_message_panic_t;
+
+typedef struct audio_synth_message_song_play_t
+{
+  const audio_synth_song_t *song; // song to play (must outlive playback)
+  uint8_t voice;                  // first voice used, channel n -> voice + n
+} audio_synth_message_song_play_t;
+
+typedef struct audio_synth_message_tune_play_t
+{
+  const audio_synth_tune_t *tune; // tune to play (must outlive playback)
+  uint8_t voice;                  // first voice used, track n -> voice + n
+} audio_synth_message_tune_play_t;
+
 typedef struct audio_synth_message_t
 {
   audio_synth_message_type_t type;
+  uint32_t time_us; // input arrival time (time_us_32) for latency stats, 0 = none
   union
   {
     audio_synth_message_note_on_t note_on;
     audio_synth_message_note_off_t note_off;
     audio_synth_message_panic_t panic;
+    audio_synth_message_song_play_t song_play;
+    audio_synth_message_tune_play_t tune_play;
   } data;
 } audio_synth_message_t;
 
@@ -143,6 +168,86 @@ typedef struct audio_synth_voice_t
   audio_synth_t *synth;
 } audio_synth_voice_t;
 
+// operator configs for a whole voice, applied together
+typedef struct audio_synth_instrument_t
+{
+  audio_synth_operator_config_t ops[AUDIO_SYNTH_OPERATOR_COUNT];
+} audio_synth_instrument_t;
+
+// a tracker song. lives in flash; pattern data is packed as described in
+// sequencer.h.
+typedef struct audio_synth_song_t
+{
+  uint8_t channels;      // channel count (<= AUDIO_SYNTH_VOICE_COUNT)
+  uint8_t bpm;           // initial tempo in beats per minute
+  uint8_t rows_per_beat; // initial rows per beat (4 = 16th notes)
+  uint8_t swing;         // initial swing (0 = straight, see sequencer.h)
+
+  uint8_t order_count;   // length of the order list
+  uint8_t restart;       // order to loop to at the end (0xff = stop)
+  const uint8_t *order;  // pattern index for each order position
+  const uint8_t *const *patterns; // packed patterns
+
+  const audio_synth_instrument_t *instruments;
+  uint8_t instrument_count;
+} audio_synth_song_t;
+
+// sequencer playback state (audio core only)
+typedef struct audio_synth_sequencer_t
+{
+  const audio_synth_song_t *song; // NULL when stopped
+  uint8_t voice;                  // first voice used by the song
+
+  uint8_t bpm;
+  uint8_t rows_per_beat;
+  uint8_t swing;
+  uint32_t row_q8; // straight row length in samples (Q24.8)
+
+  uint8_t order;       // current order position
+  uint8_t row;         // current row in the pattern
+  uint8_t row_count;   // rows in the current pattern
+  const uint8_t *next; // next packed row
+
+  // position change requested by an effect, applied before the next row
+  bool jump;
+  bool stop;
+  uint8_t jump_order;
+  uint8_t jump_row;
+
+  uint32_t countdown;   // samples until the next row
+  uint32_t frac_q8;     // fractional samples carried between rows
+
+  uint8_t velocity[AUDIO_SYNTH_VOICE_COUNT]; // per channel note velocity
+} audio_synth_sequencer_t;
+
+// one step of a baked event stream (see tune.h). 4 bytes, lives in flash.
+typedef struct audio_synth_event_t
+{
+  uint16_t delta; // timebase units since the previous event on this track
+  uint8_t note;   // MIDI note (note on), or AUDIO_SYNTH_EVENT_* command
+  uint8_t value;  // velocity for notes, instrument index for instruments
+} audio_synth_event_t;
+
+// a set of event streams played in lockstep, one voice per track
+typedef struct audio_synth_tune_t
+{
+  uint8_t track_count; // <= AUDIO_SYNTH_VOICE_COUNT
+  const audio_synth_event_t *const *tracks;
+  const audio_synth_instrument_t *instruments;
+  uint8_t instrument_count;
+  bool loop; // restart once every track has ended
+} audio_synth_tune_t;
+
+// tune playback state (audio core only)
+typedef struct audio_synth_tune_player_t
+{
+  const audio_synth_tune_t *tune; // NULL when stopped
+  uint8_t voice;                  // first voice used by the tune
+  uint8_t active;                 // bitmask of tracks still playing
+  const audio_synth_event_t *next[AUDIO_SYNTH_VOICE_COUNT];
+  uint32_t wait[AUDIO_SYNTH_VOICE_COUNT]; // samples until next[track]
+} audio_synth_tune_player_t;
+
 typedef struct audio_synth_t
 {
   float sample_rate;
@@ -152,6 +257,9 @@ typedef struct audio_synth_t
   q1x15 master_level;
 
   audio_synth_voice_t voices[AUDIO_SYNTH_VOICE_COUNT];
+  audio_synth_sequencer_t sequencer;
+  audio_synth_tune_player_t tune_player;
+  audio_analysis_t analysis; // optional output analysis, see analysis.h
 
   queue_t msg_queue; // message queue for thread-safe operation
   mutex_t mutex;     // mutex for any thread-safe operations
@@ -160,6 +268,9 @@ typedef struct audio_synth_t
 // thread-safe update operator values based on active config
 void audio_synth_operator_set_config(audio_synth_operator_t *op,
                                      audio_synth_operator_config_t config);
+// update operator values without locking (internal, audio core only)
+void audio_synth_operator_apply_config(audio_synth_operator_t *op,
+                                       audio_synth_operator_config_t config);
 
 // turn on a note for a voice
 void audio_synth_voice_note_on(audio_synth_voice_t *voice, uint16_t note_number,
@@ -181,7 +292,8 @@ void audio_synth_init(audio_synth_t *synth, float sample_rate,
 
 void audio_synth_reset_voices(audio_synth_t *synth);
 
-// panic the synthesizer (stop all voices)
+// panic the synthesizer (stop all voices, song and tune). call with
+// synth->mutex held, the audio core reads what it clears
 void audio_synth_panic(audio_synth_t *synth);
 
 // handle a message for the synthesizer
@@ -189,34 +301,32 @@ void audio_synth_handle_message(audio_synth_t *synth,
                                 audio_synth_message_t *msg);
 
 // thread-safe, core-safe enqueue a message for the synthesizer
-// messages may be dropped if the queue is full
-void audio_synth_enqueue(audio_synth_t *synth, audio_synth_message_t *msg);
+// messages may be dropped if the queue is full, returns false if so
+bool audio_synth_enqueue(audio_synth_t *synth, audio_synth_message_t *msg);
 
 // fill a buffer with samples from the synthesizer
 void audio_synth_fill_buffer(audio_synth_t *synth, audio_buffer_t buffer,
                              uint32_t buffer_size);
 
-// convert a note name (e.g. "C4", "A#3") to a MIDI note number
-static inline uint16_t note(char *name)
+// MIDI note numbers by name, resolved at compile time: NOTE(C, 4) == 60
+enum
 {
-  static const char *order[] = {"C", "C#", "D", "D#", "E", "F",
-                                "F#", "G", "G#", "A", "A#", "B"};
-  int note = 0;
-  for (; note < 12; note++)
-  {
-    if (strncmp(name, order[note], strlen(order[note])) == 0)
-    {
-      break;
-    }
-  }
-
-  int len = strlen(name);
-  int note_len = strlen(order[note]);
-  int octave = 3;
-  if ((len - note_len) == 1)
-  {
-    octave = name[len - 1] - '0';
-  }
-  int note_num = 60 + note + (octave - 4) * 12; // C4 = 60
-  return note_num;
-}
+  NOTE_C = 0,
+  NOTE_Cs = 1,
+  NOTE_Db = 1,
+  NOTE_D = 2,
+  NOTE_Ds = 3,
+  NOTE_Eb = 3,
+  NOTE_E = 4,
+  NOTE_F = 5,
+  NOTE_Fs = 6,
+  NOTE_Gb = 6,
+  NOTE_G = 7,
+  NOTE_Gs = 8,
+  NOTE_Ab = 8,
+  NOTE_A = 9,
+  NOTE_As = 10,
+  NOTE_Bb = 10,
+  NOTE_B = 11,
+};
+#define NOTE(name, octave) (NOTE_##name + ((octave) + 1) * 12)
@@ -0,0 +1,136 @@
+#include "tune.h"
+
+static void rewind_tracks(audio_synth_t *synth)
+{
+  audio_synth_tune_player_t *player = &synth->tune_player;
+  const audio_synth_tune_t *tune = player->tune;
+  player->active = 0;
+  for (uint8_t track = 0; track < tune->track_count; track++)
+  {
+    if (player->voice + track >= AUDIO_SYNTH_VOICE_COUNT)
+      break;
+    player->next[track] = tune->tracks[track];
+    player->wait[track] = player->next[track]->delta * synth->d_timebase;
+    player->active |= 1u << track;
+  }
+}
+
+// run one event. returns false once the track has ended.
+static bool run_event(audio_synth_t *synth, uint8_t track,
+                      const audio_synth_event_t *event)
+{
+  audio_synth_tune_player_t *player = &synth->tune_player;
+  audio_synth_voice_t *voice = &synth->voices[player->voice + track];
+
+  switch (event->note)
+  {
+  case AUDIO_SYNTH_EVENT_NOTE_OFF:
+    audio_synth_voice_note_off(voice);
+    break;
+  case AUDIO_SYNTH_EVENT_INSTRUMENT:
+    if (event->value < player->tune->instrument_count)
+    {
+      const audio_synth_instrument_t *inst =
+          &player->tune->instruments[event->value];
+      for (int op_idx = 0; op_idx < AUDIO_SYNTH_OPERATOR_COUNT; op_idx++)
+        audio_synth_operator_apply_config(&voice->ops[op_idx],
+                                          inst->ops[op_idx]);
+    }
+    break;
+  case AUDIO_SYNTH_EVENT_WAIT:
+    break;
+  case AUDIO_SYNTH_EVENT_END:
+    return false;
+  default:
+    if (event->note < 0x80)
+      audio_synth_voice_note_on(voice, event->note, event->value);
+    break;
+  }
+  return true;
+}
+
+// run every event that is due on every track
+static void run_due_events(audio_synth_t *synth)
+{
+  audio_synth_tune_player_t *player = &synth->tune_player;
+  for (uint8_t track = 0; track < AUDIO_SYNTH_VOICE_COUNT; track++)
+  {
+    if (!(player->active & (1u << track)))
+      continue;
+    while (player->wait[track] == 0)
+    {
+      if (!run_event(synth, track, player->next[track]))
+      {
+        player->active &= ~(1u << track);
+        break;
+      }
+      player->next[track]++;
+      player->wait[track] = player->next[track]->delta * synth->d_timebase;
+    }
+  }
+}
+
+void audio_synth_tune_play(audio_synth_t *synth, const audio_synth_tune_t *tune,
+                           uint8_t voice)
+{
+  audio_synth_tune_stop(synth);
+  if (tune == NULL || tune->track_count == 0)
+    return;
+
+  audio_synth_tune_player_t *player = &synth->tune_player;
+  player->tune = tune;
+  player->voice = voice;
+  rewind_tracks(synth);
+}
+
+void audio_synth_tune_stop(audio_synth_t *synth)
+{
+  audio_synth_tune_player_t *player = &synth->tune_player;
+  const audio_synth_tune_t *tune = player->tune;
+  if (tune == NULL)
+    return;
+  for (uint8_t track = 0; track < tune->track_count; track++)
+  {
+    uint8_t voice_idx = player->voice + track;
+    if (voice_idx < AUDIO_SYNTH_VOICE_COUNT)
+      audio_synth_voice_note_off(&synth->voices[voice_idx]);
+  }
+  player->tune = NULL;
+}
+
+uint32_t audio_synth_tune_update(audio_synth_t *synth)
+{
+  audio_synth_tune_player_t *player = &synth->tune_player;
+  if (player->tune == NULL)
+    return UINT32_MAX;
+
+  run_due_events(synth);
+  if (player->active == 0 && player->tune->loop)
+  {
+    // every track ended together, start over. a tune with no length at all
+    // would spin here, so it only gets one retry per update.
+    rewind_tracks(synth);
+    run_due_events(synth);
+  }
+  if (player->active == 0)
+  {
+    audio_synth_tune_stop(synth);
+    return UINT32_MAX;
+  }
+
+  uint32_t until = UINT32_MAX;
+  for (uint8_t track = 0; track < AUDIO_SYNTH_VOICE_COUNT; track++)
+    if ((player->active & (1u << track)) && player->wait[track] < until)
+      until = player->wait[track];
+  return until;
+}
+
+void audio_synth_tune_advance(audio_synth_t *synth, uint32_t samples)
+{
+  audio_synth_tune_player_t *player = &synth->tune_player;
+  if (player->tune == NULL)
+    return;
+  for (uint8_t track = 0; track < AUDIO_SYNTH_VOICE_COUNT; track++)
+    if (player->active & (1u << track))
+      player->wait[track] -= samples;
+}
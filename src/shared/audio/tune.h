@@ -0,0 +1,40 @@
+// Event-stream tune player, run by the synth on the audio core.
+//
+// Tunes are written in an MML-like text notation and compiled ahead of time
+// by scripts/bake.py into arrays of audio_synth_event_t, one per track. The
+// player walks those arrays directly: no parsing or string handling happens
+// at runtime. Track n plays on synth voice (voice + n).
+//
+// Each event waits `delta` synth timebase units (1 ms as set up by the engine)
+// after the previous event on its track, then:
+//   note < 0x80                    note on with velocity `value`
+//   AUDIO_SYNTH_EVENT_NOTE_OFF     release the voice
+//   AUDIO_SYNTH_EVENT_INSTRUMENT   apply tune->instruments[value] to the voice
+//   AUDIO_SYNTH_EVENT_WAIT         nothing, used to extend long gaps
+//   AUDIO_SYNTH_EVENT_END          end of track (delta pads it to full length)
+
+#pragma once
+
+#include <stdint.h>
+
+#include "synth.h"
+
+#define AUDIO_SYNTH_EVENT_NOTE_OFF 0x80
+#define AUDIO_SYNTH_EVENT_INSTRUMENT 0x81
+#define AUDIO_SYNTH_EVENT_WAIT 0x82
+#define AUDIO_SYNTH_EVENT_END 0xff
+
+// start playing a tune from the top (internal, audio core only)
+void audio_synth_tune_play(audio_synth_t *synth, const audio_synth_tune_t *tune,
+                           uint8_t voice);
+
+// stop the tune and release its voices (internal, audio core only)
+void audio_synth_tune_stop(audio_synth_t *synth);
+
+// play any events due now and return the samples until the next one, or
+// UINT32_MAX when stopped (internal, audio core only)
+uint32_t audio_synth_tune_update(audio_synth_t *synth);
+
+// account for rendered samples, never more than the last update() returned
+// (internal, audio core only)
+void audio_synth_tune_advance(audio_synth_t *synth, uint32_t samples);
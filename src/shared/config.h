@@ -7,8 +7,19 @@
 //// SYSTEM CONFIGURATION ////
 #define TARGET_FPS 120
 static const uint32_t TARGET_FRAME_INTERVAL_US = 1000000 / TARGET_FPS;
+// frame rate while nothing moves: no animations, input, redraw requests or
+// screen changes for IDLE_AFTER_US. must stay well above the 200 ms watchdog.
+#define IDLE_FPS 15
+static const uint32_t IDLE_FRAME_INTERVAL_US = 1000000 / IDLE_FPS;
+#define IDLE_AFTER_US 500000
 #define TICK_RATE 1000 // 1000 ticks per second (tune if needed)
 static const uint32_t TICK_INTERVAL_US = 1000000 / TICK_RATE;
+// memory for engine_alloc(), handed out to the running app and reset when
+// the app changes
+#define APP_ARENA_SIZE (16 * 1024)
+// input log entries for a session recorded from the menu (input_log.h), 8
+// bytes each
+#define INPUT_LOG_RECORD_CAPACITY 1024
 
 //// DISPLAY CONFIGURATION ////
 #define DISP_WIDTH 128
@@ -24,3 +35,8 @@ static const uint32_t DISP_PIX = DISP_WIDTH * DISP_HEIGHT;
 // unnecessary.
 #define AUDIO_SAMPLE_RATE 48000
 #define AUDIO_SYNTH_TIMEBASE 1000 // 1 second
+
+//// MIDI CONFIGURATION ////
+// external MIDI input (midi_input.h) plays on the synth voices from this one
+// up. apps keep to the voices below it, so incoming notes never take theirs
+#define MIDI_INPUT_FIRST_VOICE 4
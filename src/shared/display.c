@@ -0,0 +1,50 @@
+#include <string.h>
+
+#include "display.h"
+
+#define TILE_BYTES 8
+
+bool display_send_buffer(display_t *display) {
+  u8g2_t *u8g2 = display_get_u8g2(display);
+  uint8_t *buf = u8g2_GetBufferPtr(u8g2);
+  uint8_t tile_width = u8g2_GetBufferTileWidth(u8g2);
+  uint8_t tile_height = u8g2_GetBufferTileHeight(u8g2);
+  uint16_t row_bytes = tile_width * TILE_BYTES;
+
+  if ((uint32_t)row_bytes * tile_height > sizeof(display->last_frame)) {
+    // buffer doesn't fit the copy, nothing to compare against
+    u8g2_SendBuffer(u8g2);
+    return true;
+  }
+
+  bool sent = false;
+  for (uint8_t ty = 0; ty < tile_height; ty++) {
+    uint8_t *row = buf + ty * row_bytes;
+    uint8_t *last = display->last_frame + ty * row_bytes;
+
+    // one span per tile row, from the first to the last changed tile
+    uint8_t first = 0;
+    uint8_t end = tile_width;
+    if (display->last_valid) {
+      while (first < end && memcmp(row + first * TILE_BYTES,
+                                   last + first * TILE_BYTES, TILE_BYTES) == 0)
+        first++;
+      while (end > first && memcmp(row + (end - 1) * TILE_BYTES,
+                                   last + (end - 1) * TILE_BYTES,
+                                   TILE_BYTES) == 0)
+        end--;
+      if (first == end)
+        continue;
+    }
+
+    u8g2_UpdateDisplayArea(u8g2, first, ty, end - first, 1);
+    memcpy(last + first * TILE_BYTES, row + first * TILE_BYTES,
+           (end - first) * TILE_BYTES);
+    sent = true;
+  }
+  display->last_valid = true;
+
+  if (sent)
+    u8x8_RefreshDisplay(u8g2_GetU8x8(u8g2));
+  return sent;
+}
@@ -2,11 +2,20 @@
 
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include <u8g2.h>
 
+#include "config.h"
+
 typedef struct {
   u8g2_t u8g2;
   bool enabled;
+
+  // copy of what the panel currently shows, in u8g2 tile buffer layout
+  uint8_t last_frame[DISP_WIDTH * DISP_HEIGHT / 8];
+  bool last_valid; // false forces the next send to push everything
 } display_t;
 
 static inline u8g2_t *display_get_u8g2(display_t *display) {
@@ -15,3 +24,12 @@ static inline u8g2_t *display_get_u8g2(display_t *display) {
 
 void display_init(display_t *display);
 void display_set_enabled(display_t *display, bool enabled);
+
+// send the tiles that changed since the last send (shared/display.c).
+// returns false and skips the transfer entirely if nothing changed.
+bool display_send_buffer(display_t *display);
+
+// forget what the panel shows, e.g. after it was cleared or powered up
+static inline void display_invalidate(display_t *display) {
+  display->last_valid = false;
+}
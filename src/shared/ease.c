@@ -0,0 +1,30 @@
+#include <math.h>
+
+#include "ease.h"
+#include "ease_tables.h"
+
+static float bezier(float t, float p1, float p2) {
+  float inv = 1.0f - t;
+  return 3.0f * inv * inv * t * p1 + 3.0f * inv * t * t * p2 + t * t * t;
+}
+
+void ease_bake_bezier(ease_table_t table, float x1, float y1, float x2,
+                      float y2) {
+  // walk t once: x rises monotonically for x1, x2 in 0..1
+  float t = 0.0f;
+  const float dt = 1.0f / 1024.0f;
+  for (int i = 0; i < EASE_TABLE_SIZE; i++) {
+    float x = (float)i / (EASE_TABLE_SIZE - 1);
+    while (t < 1.0f && bezier(t + dt, x1, x2) <= x)
+      t += dt;
+    // interpolate within the step for the t that lands on x
+    float x0 = bezier(t, x1, x2);
+    float xn = bezier(t + dt, x1, x2);
+    float at = xn > x0 ? t + dt * (x - x0) / (xn - x0) : t;
+    if (at > 1.0f)
+      at = 1.0f;
+    table[i] = (int32_t)floorf(bezier(at, y1, y2) * 65536.0f + 0.5f);
+  }
+  table[0] = 0;
+  table[EASE_TABLE_SIZE - 1] = 65536;
+}
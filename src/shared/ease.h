@@ -0,0 +1,66 @@
+// Easing curves.
+// Every curve is baked into a Q16.16 table (ease_tables.h, from
+// scripts/bake.py, compiled into ease.c only) and looked up with linear
+// interpolation, so a spring-ish elastic costs the same as linear and no
+// floats are involved. Progress and results are Q16.16, 65536 = 1. back and
+// elastic overshoot past 0..1.
+//
+// Custom curves (e.g. a CSS style cubic Bezier) can be baked into an
+// ease_table_t at startup and used through ease_table().
+
+#pragma once
+
+#include <stdint.h>
+
+#define EASE_TABLE_BITS 7 // keep in sync with scripts/bake.py
+#define EASE_TABLE_SIZE ((1 << EASE_TABLE_BITS) + 1)
+
+// keep in sync with EASE_CURVES in scripts/bake.py
+typedef enum {
+  EASE_LINEAR,
+  EASE_IN_QUAD,
+  EASE_OUT_QUAD,
+  EASE_INOUT_QUAD,
+  EASE_IN_CUBIC,
+  EASE_OUT_CUBIC,
+  EASE_INOUT_CUBIC,
+  EASE_IN_BACK,
+  EASE_OUT_BACK,
+  EASE_OUT_ELASTIC,
+  EASE_OUT_BOUNCE,
+  EASE_IN_BOUNCE,
+  EASE_COUNT,
+} ease_t;
+
+typedef int32_t ease_table_t[EASE_TABLE_SIZE];
+
+// the baked tables, by ease_t (defined once, in ease.c)
+extern const int32_t *const EASE_TABLES[EASE_COUNT];
+
+// eased value of progress p_q16 (0..65536, clamped) on a baked table
+static inline int32_t ease_table(const int32_t *table, uint32_t p_q16) {
+  if (p_q16 >= 65536u)
+    return table[EASE_TABLE_SIZE - 1];
+  uint32_t i = p_q16 >> (16 - EASE_TABLE_BITS);
+  int32_t frac = p_q16 & ((1u << (16 - EASE_TABLE_BITS)) - 1);
+  int32_t a = table[i];
+  return a + (((table[i + 1] - a) * frac) >> (16 - EASE_TABLE_BITS));
+}
+
+static inline const int32_t *ease_get_table(ease_t ease) {
+  return EASE_TABLES[ease < EASE_COUNT ? ease : EASE_LINEAR];
+}
+
+static inline int32_t ease_q16(ease_t ease, uint32_t p_q16) {
+  return ease_table(ease_get_table(ease), p_q16);
+}
+
+// scale an eased value, e.g. a width in pixels for progress p_q16
+static inline int32_t ease_scale(ease_t ease, uint32_t p_q16, int32_t scale) {
+  return (int32_t)(((int64_t)ease_q16(ease, p_q16) * scale) >> 16);
+}
+
+// bake a cubic Bezier from (0, 0) to (1, 1) with control points (x1, y1) and
+// (x2, y2), like CSS cubic-bezier(). uses floats, do it once at startup.
+void ease_bake_bezier(ease_table_t table, float x1, float y1, float x2,
+                      float y2);
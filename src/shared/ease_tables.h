@@ -0,0 +1,267 @@
+// This file is auto-generated by scripts/bake.py. Do not edit manually.
+
+#pragma once
+
+
+#include <stdint.h>
+
+
+// included by src/shared/ease.c only, after ease.h
+#if EASE_TABLE_BITS != 7
+#error "EASE_TABLE_BITS in ease.h does not match scripts/bake.py"
+#endif
+
+static const int32_t EASE_LINEAR_TABLE[129] = {
+  0, 512, 1024, 1536, 2048, 2560, 3072, 3584,
+  4096, 4608, 5120, 5632, 6144, 6656, 7168, 7680,
+  8192, 8704, 9216, 9728, 10240, 10752, 11264, 11776,
+  12288, 12800, 13312, 13824, 14336, 14848, 15360, 15872,
+  16384, 16896, 17408, 17920, 18432, 18944, 19456, 19968,
+  20480, 20992, 21504, 22016, 22528, 23040, 23552, 24064,
+  24576, 25088, 25600, 26112, 26624, 27136, 27648, 28160,
+  28672, 29184, 29696, 30208, 30720, 31232, 31744, 32256,
+  32768, 33280, 33792, 34304, 34816, 35328, 35840, 36352,
+  36864, 37376, 37888, 38400, 38912, 39424, 39936, 40448,
+  40960, 41472, 41984, 42496, 43008, 43520, 44032, 44544,
+  45056, 45568, 46080, 46592, 47104, 47616, 48128, 48640,
+  49152, 49664, 50176, 50688, 51200, 51712, 52224, 52736,
+  53248, 53760, 54272, 54784, 55296, 55808, 56320, 56832,
+  57344, 57856, 58368, 58880, 59392, 59904, 60416, 60928,
+  61440, 61952, 62464, 62976, 63488, 64000, 64512, 65024,
+  65536,
+};
+
+static const int32_t EASE_IN_QUAD_TABLE[129] = {
+  0, 4, 16, 36, 64, 100, 144, 196,
+  256, 324, 400, 484, 576, 676, 784, 900,
+  1024, 1156, 1296, 1444, 1600, 1764, 1936, 2116,
+  2304, 2500, 2704, 2916, 3136, 3364, 3600, 3844,
+  4096, 4356, 4624, 4900, 5184, 5476, 5776, 6084,
+  6400, 6724, 7056, 7396, 7744, 8100, 8464, 8836,
+  9216, 9604, 10000, 10404, 10816, 11236, 11664, 12100,
+  12544, 12996, 13456, 13924, 14400, 14884, 15376, 15876,
+  16384, 16900, 17424, 17956, 18496, 19044, 19600, 20164,
+  20736, 21316, 21904, 22500, 23104, 23716, 24336, 24964,
+  25600, 26244, 26896, 27556, 28224, 28900, 29584, 30276,
+  30976, 31684, 32400, 33124, 33856, 34596, 35344, 36100,
+  36864, 37636, 38416, 39204, 40000, 40804, 41616, 42436,
+  43264, 44100, 44944, 45796, 46656, 47524, 48400, 49284,
+  50176, 51076, 51984, 52900, 53824, 54756, 55696, 56644,
+  57600, 58564, 59536, 60516, 61504, 62500, 63504, 64516,
+  65536,
+};
+
+static const int32_t EASE_OUT_QUAD_TABLE[129] = {
+  0, 1020, 2032, 3036, 4032, 5020, 6000, 6972,
+  7936, 8892, 9840, 10780, 11712, 12636, 13552, 14460,
+  15360, 16252, 17136, 18012, 18880, 19740, 20592, 21436,
+  22272, 23100, 23920, 24732, 25536, 26332, 27120, 27900,
+  28672, 29436, 30192, 30940, 31680, 32412, 33136, 33852,
+  34560, 35260, 35952, 36636, 37312, 37980, 38640, 39292,
+  39936, 40572, 41200, 41820, 42432, 43036, 43632, 44220,
+  44800, 45372, 45936, 46492, 47040, 47580, 48112, 48636,
+  49152, 49660, 50160, 50652, 51136, 51612, 52080, 52540,
+  52992, 53436, 53872, 54300, 54720, 55132, 55536, 55932,
+  56320, 56700, 57072, 57436, 57792, 58140, 58480, 58812,
+  59136, 59452, 59760, 60060, 60352, 60636, 60912, 61180,
+  61440, 61692, 61936, 62172, 62400, 62620, 62832, 63036,
+  63232, 63420, 63600, 63772, 63936, 64092, 64240, 64380,
+  64512, 64636, 64752, 64860, 64960, 65052, 65136, 65212,
+  65280, 65340, 65392, 65436, 65472, 65500, 65520, 65532,
+  65536,
+};
+
+static const int32_t EASE_INOUT_QUAD_TABLE[129] = {
+  0, 8, 32, 72, 128, 200, 288, 392,
+  512, 648, 800, 968, 1152, 1352, 1568, 1800,
+  2048, 2312, 2592, 2888, 3200, 3528, 3872, 4232,
+  4608, 5000, 5408, 5832, 6272, 6728, 7200, 7688,
+  8192, 8712, 9248, 9800, 10368, 10952, 11552, 12168,
+  12800, 13448, 14112, 14792, 15488, 16200, 16928, 17672,
+  18432, 19208, 20000, 20808, 21632, 22472, 23328, 24200,
+  25088, 25992, 26912, 27848, 28800, 29768, 30752, 31752,
+  32768, 33784, 34784, 35768, 36736, 37688, 38624, 39544,
+  40448, 41336, 42208, 43064, 43904, 44728, 45536, 46328,
+  47104, 47864, 48608, 49336, 50048, 50744, 51424, 52088,
+  52736, 53368, 53984, 54584, 55168, 55736, 56288, 56824,
+  57344, 57848, 58336, 58808, 59264, 59704, 60128, 60536,
+  60928, 61304, 61664, 62008, 62336, 62648, 62944, 63224,
+  63488, 63736, 63968, 64184, 64384, 64568, 64736, 64888,
+  65024, 65144, 65248, 65336, 65408, 65464, 65504, 65528,
+  65536,
+};
+
+static const int32_t EASE_IN_CUBIC_TABLE[129] = {
+  0, 0, 0, 1, 2, 4, 7, 11,
+  16, 23, 31, 42, 54, 69, 86, 105,
+  128, 154, 182, 214, 250, 289, 333, 380,
+  432, 488, 549, 615, 686, 762, 844, 931,
+  1024, 1123, 1228, 1340, 1458, 1583, 1715, 1854,
+  2000, 2154, 2315, 2485, 2662, 2848, 3042, 3244,
+  3456, 3677, 3906, 4145, 4394, 4652, 4921, 5199,
+  5488, 5787, 6097, 6418, 6750, 7093, 7448, 7814,
+  8192, 8582, 8984, 9399, 9826, 10266, 10719, 11185,
+  11664, 12157, 12663, 13184, 13718, 14267, 14830, 15407,
+  16000, 16608, 17230, 17868, 18522, 19191, 19877, 20578,
+  21296, 22030, 22781, 23549, 24334, 25136, 25956, 26793,
+  27648, 28521, 29412, 30322, 31250, 32197, 33163, 34148,
+  35152, 36176, 37219, 38283, 39366, 40470, 41594, 42738,
+  43904, 45091, 46298, 47527, 48778, 50050, 51345, 52661,
+  54000, 55361, 56745, 58152, 59582, 61035, 62512, 64012,
+  65536,
+};
+
+static const int32_t EASE_OUT_CUBIC_TABLE[129] = {
+  0, 1524, 3024, 4501, 5954, 7384, 8791, 10175,
+  11536, 12875, 14191, 15486, 16758, 18009, 19238, 20445,
+  21632, 22798, 23942, 25066, 26170, 27253, 28317, 29360,
+  30384, 31388, 32373, 33339, 34286, 35214, 36124, 37015,
+  37888, 38743, 39580, 40400, 41202, 41987, 42755, 43506,
+  44240, 44958, 45659, 46345, 47014, 47668, 48306, 48928,
+  49536, 50129, 50706, 51269, 51818, 52352, 52873, 53379,
+  53872, 54351, 54817, 55270, 55710, 56137, 56552, 56954,
+  57344, 57722, 58088, 58443, 58786, 59118, 59439, 59749,
+  60048, 60337, 60615, 60884, 61142, 61391, 61630, 61859,
+  62080, 62292, 62494, 62688, 62874, 63051, 63221, 63382,
+  63536, 63682, 63821, 63953, 64078, 64196, 64308, 64413,
+  64512, 64605, 64692, 64774, 64850, 64921, 64987, 65048,
+  65104, 65156, 65203, 65247, 65286, 65322, 65354, 65382,
+  65408, 65431, 65450, 65467, 65482, 65494, 65505, 65513,
+  65520, 65525, 65529, 65532, 65534, 65535, 65536, 65536,
+  65536,
+};
+
+static const int32_t EASE_INOUT_CUBIC_TABLE[129] = {
+  0, 0, 1, 3, 8, 16, 27, 43,
+  64, 91, 125, 166, 216, 275, 343, 422,
+  512, 614, 729, 857, 1000, 1158, 1331, 1521,
+  1728, 1953, 2197, 2460, 2744, 3049, 3375, 3724,
+  4096, 4492, 4913, 5359, 5832, 6332, 6859, 7415,
+  8000, 8615, 9261, 9938, 10648, 11391, 12167, 12978,
+  13824, 14706, 15625, 16581, 17576, 18610, 19683, 20797,
+  21952, 23149, 24389, 25672, 27000, 28373, 29791, 31256,
+  32768, 34280, 35745, 37163, 38536, 39864, 41147, 42387,
+  43584, 44739, 45853, 46926, 47960, 48955, 49911, 50830,
+  51712, 52558, 53369, 54145, 54888, 55598, 56275, 56921,
+  57536, 58121, 58677, 59204, 59704, 60177, 60623, 61044,
+  61440, 61812, 62161, 62487, 62792, 63076, 63339, 63583,
+  63808, 64015, 64205, 64378, 64536, 64679, 64807, 64922,
+  65024, 65114, 65193, 65261, 65320, 65370, 65411, 65445,
+  65472, 65493, 65509, 65520, 65528, 65533, 65535, 65536,
+  65536,
+};
+
+static const int32_t EASE_IN_BACK_TABLE[129] = {
+  0, -7, -27, -59, -103, -160, -227, -305,
+  -392, -490, -596, -711, -834, -965, -1102, -1246,
+  -1397, -1552, -1713, -1878, -2047, -2220, -2395, -2573,
+  -2753, -2935, -3117, -3300, -3483, -3665, -3846, -4026,
+  -4203, -4378, -4550, -4718, -4882, -5042, -5196, -5344,
+  -5487, -5623, -5752, -5873, -5985, -6090, -6185, -6270,
+  -6345, -6410, -6463, -6504, -6534, -6550, -6553, -6543,
+  -6518, -6479, -6424, -6354, -6267, -6164, -6043, -5904,
+  -5747, -5572, -5377, -5162, -4927, -4671, -4393, -4094,
+  -3773, -3428, -3061, -2669, -2253, -1812, -1346, -854,
+  -335, 210, 783, 1384, 2013, 2671, 3359, 4077,
+  4825, 5604, 6414, 7257, 8132, 9039, 9981, 10956,
+  11966, 13011, 14092, 15208, 16361, 17551, 18779, 20045,
+  21349, 22692, 24075, 25498, 26961, 28466, 30012, 31601,
+  33232, 34906, 36623, 38385, 40192, 42043, 43941, 45884,
+  47874, 49912, 51997, 54130, 56312, 58543, 60823, 63154,
+  65536,
+};
+
+static const int32_t EASE_OUT_BACK_TABLE[129] = {
+  0, 2382, 4713, 6993, 9224, 11406, 13539, 15624,
+  17662, 19652, 21595, 23493, 25344, 27151, 28913, 30630,
+  32304, 33935, 35524, 37070, 38575, 40038, 41461, 42844,
+  44187, 45491, 46757, 47985, 49175, 50328, 51444, 52525,
+  53570, 54580, 55555, 56497, 57404, 58279, 59122, 59932,
+  60711, 61459, 62177, 62865, 63523, 64152, 64753, 65326,
+  65871, 66390, 66882, 67348, 67789, 68205, 68597, 68964,
+  69309, 69630, 69929, 70207, 70463, 70698, 70913, 71108,
+  71283, 71440, 71579, 71700, 71803, 71890, 71960, 72015,
+  72054, 72079, 72089, 72086, 72070, 72040, 71999, 71946,
+  71881, 71806, 71721, 71626, 71521, 71409, 71288, 71159,
+  71023, 70880, 70732, 70578, 70418, 70254, 70086, 69914,
+  69739, 69562, 69382, 69201, 69019, 68836, 68653, 68471,
+  68289, 68109, 67931, 67756, 67583, 67414, 67249, 67088,
+  66933, 66782, 66638, 66501, 66370, 66247, 66132, 66026,
+  65928, 65841, 65763, 65696, 65639, 65595, 65563, 65543,
+  65536,
+};
+
+static const int32_t EASE_OUT_ELASTIC_TABLE[129] = {
+  0, 4284, 9848, 16405, 23669, 31363, 39227, 47022,
+  54538, 61590, 68030, 73739, 78631, 82653, 85782, 88021,
+  89399, 89965, 89787, 88946, 87534, 85649, 83393, 80867,
+  78170, 75394, 72627, 69945, 67414, 65090, 63017, 61228,
+  59743, 58574, 57720, 57173, 56917, 56930, 57183, 57644,
+  58280, 59054, 59931, 60875, 61854, 62835, 63791, 64698,
+  65536, 66288, 66941, 67488, 67924, 68248, 68463, 68573,
+  68587, 68514, 68364, 68151, 67886, 67582, 67252, 66908,
+  66560, 66219, 65895, 65593, 65321, 65083, 64881, 64719,
+  64597, 64513, 64467, 64456, 64476, 64524, 64595, 64685,
+  64790, 64905, 65027, 65149, 65271, 65387, 65495, 65594,
+  65681, 65754, 65814, 65860, 65893, 65912, 65918, 65913,
+  65898, 65874, 65844, 65807, 65767, 65725, 65681, 65638,
+  65597, 65558, 65522, 65491, 65464, 65441, 65424, 65412,
+  65404, 65401, 65402, 65407, 65414, 65425, 65437, 65451,
+  65466, 65482, 65497, 65512, 65526, 65538, 65550, 65560,
+  65536,
+};
+
+static const int32_t EASE_OUT_BOUNCE_TABLE[129] = {
+  0, 30, 121, 272, 484, 756, 1089, 1482,
+  1936, 2450, 3025, 3660, 4356, 5112, 5929, 6806,
+  7744, 8742, 9801, 10920, 12100, 13340, 14641, 16002,
+  17424, 18906, 20449, 22052, 23716, 25440, 27225, 29070,
+  30976, 32942, 34969, 37056, 39204, 41412, 43681, 46010,
+  48400, 50850, 53361, 55932, 58564, 61256, 64009, 64902,
+  63552, 62262, 61033, 59864, 58756, 57708, 56721, 55794,
+  54928, 54122, 53377, 52692, 52068, 51504, 51001, 50558,
+  50176, 49854, 49593, 49392, 49252, 49172, 49153, 49194,
+  49296, 49458, 49681, 49964, 50308, 50712, 51177, 51702,
+  52288, 52934, 53641, 54408, 55236, 56124, 57073, 58082,
+  59152, 60282, 61473, 62724, 64036, 65408, 64921, 64302,
+  63744, 63246, 62809, 62432, 62116, 61860, 61665, 61530,
+  61456, 61442, 61489, 61596, 61764, 61992, 62281, 62630,
+  63040, 63510, 64041, 64632, 65284, 65324, 65041, 64818,
+  64656, 64554, 64513, 64532, 64612, 64752, 64953, 65214,
+  65536,
+};
+
+static const int32_t EASE_IN_BOUNCE_TABLE[129] = {
+  0, 322, 583, 784, 924, 1004, 1023, 982,
+  880, 718, 495, 212, 252, 904, 1495, 2026,
+  2496, 2906, 3255, 3544, 3772, 3940, 4047, 4094,
+  4080, 4006, 3871, 3676, 3420, 3104, 2727, 2290,
+  1792, 1234, 615, 128, 1500, 2812, 4063, 5254,
+  6384, 7454, 8463, 9412, 10300, 11128, 11895, 12602,
+  13248, 13834, 14359, 14824, 15228, 15572, 15855, 16078,
+  16240, 16342, 16383, 16364, 16284, 16144, 15943, 15682,
+  15360, 14978, 14535, 14032, 13468, 12844, 12159, 11414,
+  10608, 9742, 8815, 7828, 6780, 5672, 4503, 3274,
+  1984, 634, 1527, 4280, 6972, 9604, 12175, 14686,
+  17136, 19526, 21855, 24124, 26332, 28480, 30567, 32594,
+  34560, 36466, 38311, 40096, 41820, 43484, 45087, 46630,
+  48112, 49534, 50895, 52196, 53436, 54616, 55735, 56794,
+  57792, 58730, 59607, 60424, 61180, 61876, 62511, 63086,
+  63600, 64054, 64447, 64780, 65052, 65264, 65415, 65506,
+  65536,
+};
+
+const int32_t *const EASE_TABLES[EASE_COUNT] = {
+  EASE_LINEAR_TABLE,
+  EASE_IN_QUAD_TABLE,
+  EASE_OUT_QUAD_TABLE,
+  EASE_INOUT_QUAD_TABLE,
+  EASE_IN_CUBIC_TABLE,
+  EASE_OUT_CUBIC_TABLE,
+  EASE_INOUT_CUBIC_TABLE,
+  EASE_IN_BACK_TABLE,
+  EASE_OUT_BACK_TABLE,
+  EASE_OUT_ELASTIC_TABLE,
+  EASE_OUT_BOUNCE_TABLE,
+  EASE_IN_BOUNCE_TABLE,
+};
@@ -1,25 +1,45 @@
+#include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <hardware/divider.h>
 #include <hardware/watchdog.h>
 
+#include <shared/utils/arena.h>
 #include <shared/utils/elm.h>
-#include <shared/utils/timing.h>
 #include <shared/utils/vec.h>
 
 #include "anim.h"
 #include "apps/apps.h"
+#include "audio/stats.h"
 #include "engine.h"
+#include "input.h"
+#include "memory.h"
+#include "midi_input.h"
+#include "profile.h"
+#include "telemetry.h"
+#include "trace.h"
 
 // #define DEBUG_FPS
+// print the per second stats as text too. off by default, text on stdio can
+// land inside a telemetry frame and break it
+// #define DEBUG_LOG
 
 // global engine instance
 engine_t g_engine;
 
+// app memory, see engine_alloc()
+static uint8_t app_arena_buffer[APP_ARENA_SIZE] __attribute__((aligned(8)));
+static arena_t app_arena;
+
 void engine_init()
 {
   // initialize all subsystems
   audio_synth_init(&g_engine.synth, AUDIO_SAMPLE_RATE, 1000);
+  audio_synth_midi_init(&g_engine.midi, &g_engine.synth,
+                        MIDI_INPUT_FIRST_VOICE,
+                        AUDIO_SYNTH_VOICE_COUNT - MIDI_INPUT_FIRST_VOICE);
+  midi_input_init(&g_engine.midi, NULL);
 
   display_init(&g_engine.display);
   peripheral_init(&g_engine.peripheral);
@@ -29,6 +49,9 @@ void engine_init()
   g_engine.buttons.right.id = BUTTON_RIGHT;
   g_engine.buttons.menu.id = BUTTON_MENU;
   engine_buttons_init(&g_engine.buttons);
+  anim_init();
+  profile_init();
+  arena_init(&app_arena, app_arena_buffer, sizeof(app_arena_buffer));
 
   engine_set_app(&app_morse);
   engine_set_volume(4); // todo: save/restore from flash (somehow)
@@ -66,17 +89,52 @@ static void draw_fps(u8g2_t *u8g2, uint32_t fps)
   u8g2_DrawStr(u8g2, 3, 4, fps_str);
 }
 
-static void read_button(button_t *button, absolute_time_t now)
+static struct
 {
-  button->edge = false;
-  bool pressed = engine_button_read(button->id);
-  if (pressed)
+  input_log_t *record;       // recording into, or NULL
+  bool replaying;
+  input_log_player_t player; // when replaying
+  absolute_time_t start;     // edge times in the log are relative to this
+  uint32_t start_tick;       // log ticks are relative to this
+} input_log;
+
+// a session recorded from the menu, sent over telemetry once it stops
+static input_log_entry_t recording_entries[INPUT_LOG_RECORD_CAPACITY];
+static input_log_t recording = {.entries = recording_entries,
+                                .capacity = INPUT_LOG_RECORD_CAPACITY};
+static struct
+{
+  bool active;
+  bool started;    // start record sent
+  uint32_t cursor; // next entry to send
+} recording_dump;
+
+static void set_edge(button_t *button, absolute_time_t time)
+{
+  button->edge = true;
+  button->prev_edge_at = button->edge_at;
+  button->edge_at = time;
+}
+
+// apply one input event to its button. returns false if the button still has
+// an unconsumed edge, in which case the event has to wait for the next tick
+// or frame so that no transition is lost.
+static bool apply_input_event(const input_event_t *event)
+{
+  button_t *button = engine_button_from_id(event->button);
+  if (button == NULL ||
+      absolute_time_diff_us(button->reset_at, event->time) < 0)
+    return true; // stale, drop
+  if (button->edge)
+    return false;
+
+  if (event->pressed)
   {
     if (!button->pressed && !button->ignore)
     {
       button->pressed = true;
-      button->pressed_at = now;
-      button->edge = true;
+      button->pressed_at = event->time;
+      set_edge(button, event->time);
     }
   }
   else
@@ -87,30 +145,98 @@ static void read_button(button_t *button, absolute_time_t now)
       // released
       button->pressed = false;
       button->pressed_at = nil_time;
-      button->edge = true;
+      set_edge(button, event->time);
     }
   }
+  if (button->edge && input_log.record != NULL)
+    input_log_record(
+        input_log.record, g_engine.uptime_ticks - input_log.start_tick,
+        button->id, button->pressed,
+        (uint32_t)absolute_time_diff_us(input_log.start, event->time));
+  return true;
 }
 
-static void reset_buttons(bool ignore_menu)
+// apply recorded edges that are due, in place of live input
+static void apply_replay()
 {
-  g_engine.buttons.left.edge = false;
-  g_engine.buttons.left.pressed = false;
-  g_engine.buttons.left.pressed_at = nil_time;
-  g_engine.buttons.left.ignore = true;
+  input_log_entry_t entry;
+  uint32_t tick = g_engine.uptime_ticks - input_log.start_tick;
+  while (input_log_player_peek(&input_log.player, tick, &entry))
+  {
+    button_t *button = engine_button_from_id(entry.button);
+    if (button != NULL)
+    {
+      if (button->edge)
+        return;
+      button->pressed = entry.pressed;
+      absolute_time_t time = delayed_by_us(input_log.start, entry.time_us);
+      button->pressed_at = entry.pressed ? time : nil_time;
+      set_edge(button, time);
+    }
+    input_log_player_pop(&input_log.player);
+  }
+  if (input_log_player_done(&input_log.player))
+  {
+    printf("replay: done after %d ticks\n", tick);
+    input_log.replaying = false;
+  }
+}
 
-  g_engine.buttons.right.edge = false;
-  g_engine.buttons.right.pressed = false;
-  g_engine.buttons.right.pressed_at = nil_time;
-  g_engine.buttons.right.ignore = true;
+// resync a button with its level after input events were dropped
+static void resync_button(button_t *button, absolute_time_t now)
+{
+  bool level = engine_button_read(button->id);
+  if (level != button->pressed && !button->edge)
+    apply_input_event(&(input_event_t){
+        .time = now, .button = button->id, .pressed = level});
+}
 
-  if (ignore_menu)
+// derive button state from the input queue, in order
+static void apply_input(absolute_time_t now)
+{
+  static uint32_t dropped = 0;
+  input_event_t event;
+  if (input_log.replaying)
   {
-    g_engine.buttons.menu.edge = false;
-    g_engine.buttons.menu.pressed = false;
-    g_engine.buttons.menu.pressed_at = nil_time;
-    g_engine.buttons.menu.ignore = true;
+    // live input is dropped while replaying
+    while (input_peek(&g_input, &event))
+      input_pop(&g_input);
+    apply_replay();
+    return;
   }
+  while (input_peek(&g_input, &event))
+  {
+    if (!apply_input_event(&event))
+      break;
+    input_pop(&g_input);
+  }
+  if (g_input.dropped != dropped && input_empty(&g_input))
+  {
+    dropped = g_input.dropped;
+    resync_button(&g_engine.buttons.left, now);
+    resync_button(&g_engine.buttons.right, now);
+    resync_button(&g_engine.buttons.menu, now);
+  }
+}
+
+static void reset_button(button_t *button)
+{
+  button->edge = false;
+  button->pressed = false;
+  button->pressed_at = nil_time;
+  button->edge_at = nil_time;
+  button->prev_edge_at = nil_time;
+  button->reset_at = get_absolute_time();
+  // a button held through the reset is ignored until it is released
+  button->ignore = engine_button_read(button->id);
+}
+
+static void reset_buttons(bool ignore_menu)
+{
+  reset_button(&g_engine.buttons.left);
+  reset_button(&g_engine.buttons.right);
+  if (ignore_menu)
+    reset_button(&g_engine.buttons.menu);
 }
 
 static void handle_menu_reset()
@@ -180,12 +306,42 @@ static void menu_action_go_home()
 
 static void menu_action_sleep() { engine_enter_sleep(); }
 
+// record a session in the running app (restarting it), or stop recording and
+// send the log over telemetry
+static void menu_action_record()
+{
+  if (recording_dump.active)
+    return; // still sending the last one
+  engine_resume();
+  if (input_log.record == NULL)
+  {
+    engine_record_start(&recording, g_engine.app);
+    return;
+  }
+  engine_record_stop();
+  // the menu presses that stopped it aren't part of the session
+  for (uint32_t i = recording.count; i-- > 0;)
+  {
+    if (recording.entries[i].button == BUTTON_MENU &&
+        recording.entries[i].pressed)
+    {
+      recording.count = i;
+      break;
+    }
+  }
+  recording_dump.active = true;
+  recording_dump.started = false;
+  recording_dump.cursor = 0;
+}
+
 static const menu_action_t menu_actions[] = {
     {.name = "go home", .action = menu_action_go_home},
     {.name = "sleep", .action = menu_action_sleep},
     {.name = "volume", .action = NULL},
+    {.name = "record", .action = menu_action_record},
 };
 static const uint8_t MENU_ACTION_VOLUME = 2;
+static const uint8_t MENU_ACTION_RECORD = 3;
 
 static const int32_t MENU_ACTION_COUNT =
     sizeof(menu_actions) / sizeof(menu_actions[0]);
@@ -208,27 +364,20 @@ static void menu_change_active(int8_t delta)
     menu_state.active = 0;
   }
   int32_t target_offset = menu_action_y(menu_state.active);
-  anim_sys_to(&menu_state.anim.active, target_offset, 150, ANIM_EASE_OUT_CUBIC,
-              NULL, NULL);
-}
-
-static inline float ease_out_cubic(float t)
-{
-  float inv = 1.0f - t;
-  return 1.0f - inv * inv * inv;
+  anim_sys_spring_to(&menu_state.anim.active, target_offset, 200, NULL, NULL);
 }
 
 static void menu_enter()
 {
   menu_state.anim.held = 0;
-  anim_sys_to(&menu_state.anim.container, 0, 300, ANIM_EASE_OUT_CUBIC, NULL,
+  anim_sys_to(&menu_state.anim.container, 0, 300, EASE_OUT_CUBIC, NULL,
               NULL);
 }
 
 static void menu_exit()
 {
   anim_sys_to(&menu_state.anim.container, MENU_CONTAINER_OFFSET_CLOSED, 300,
-              ANIM_EASE_OUT_CUBIC, NULL, NULL);
+              EASE_OUT_CUBIC, NULL, NULL);
 }
 
 static void menu_frame()
@@ -254,12 +403,12 @@ static void menu_frame()
     button_id_t button_id = engine_button_get_pressed_first();
     if (button_id != BUTTON_NONE)
     {
-      float held = engine_button_held_ratio(button_id);
-      menu_state.ignore_release = held > 0.f;
+      uint32_t held = engine_button_held_q16(button_id);
+      menu_state.ignore_release = held > 0;
       if (menu_state.active == MENU_ACTION_VOLUME)
       {
         // change volume repeatedly when held
-        if (held >= .2f)
+        if (held >= 65536 / 5)
         {
           static absolute_time_t last_change = {0};
           if (time_reached(delayed_by_ms(last_change, 200)))
@@ -276,7 +425,7 @@ static void menu_frame()
               menu_state.anim.volume_kick = 2;
             }
             anim_sys_to(&menu_state.anim.volume_kick, 0, 150,
-                        ANIM_EASE_OUT_CUBIC, NULL, NULL);
+                        EASE_OUT_CUBIC, NULL, NULL);
           }
         }
       }
@@ -286,9 +435,9 @@ static void menu_frame()
         if (held > 0)
         {
           anim_cancel(&menu_state.anim.held, false);
-          menu_state.anim.held = 14 * ease_out_cubic(held);
+          menu_state.anim.held = ease_scale(EASE_OUT_CUBIC, held, 14);
         }
-        if (held >= 1.f)
+        if (held >= 65536)
         {
           if (menu_actions[menu_state.active].action)
           {
@@ -300,7 +449,7 @@ static void menu_frame()
     }
     if (BUTTON_KEYUP(BUTTON_LEFT))
     {
-      anim_sys_to(&menu_state.anim.held, 0, 150, ANIM_EASE_OUT_CUBIC, NULL,
+      anim_sys_to(&menu_state.anim.held, 0, 150, EASE_OUT_CUBIC, NULL,
                   NULL);
       if (!menu_state.ignore_release)
         menu_change_active(-1);
@@ -309,7 +458,7 @@ static void menu_frame()
 
     if (BUTTON_KEYUP(BUTTON_RIGHT))
     {
-      anim_sys_to(&menu_state.anim.held, 0, 150, ANIM_EASE_OUT_CUBIC, NULL,
+      anim_sys_to(&menu_state.anim.held, 0, 150, EASE_OUT_CUBIC, NULL,
                   NULL);
       if (!menu_state.ignore_release)
         menu_change_active(1);
@@ -333,8 +482,10 @@ static void menu_frame()
   u8g2_SetDrawColor(u8g2, 1);
   elm_hline(&root, vec2(0, DISP_HEIGHT + 1), DISP_WIDTH);
 
-  // draw menu items
-  elm_t items = elm_child(&root, vec2(0, 10));
+  // draw menu items, scrolled to keep the active one on screen
+  int32_t scroll = MAX(0, menu_state.anim.active + MENU_ACTION_HEIGHT -
+                              (DISP_HEIGHT - 10));
+  elm_t items = elm_child(&root, vec2(0, 10 - scroll));
   u8g2_SetFont(u8g2, u8g2_font_6x10_tf);
   for (uint8_t i = 0; i < MENU_ACTION_COUNT; i++)
   {
@@ -368,7 +519,12 @@ static void menu_frame()
         elm_hline(&item, vec2(5, 9), MAX(menu_state.anim.held - 3, 0));
       }
     }
-    elm_str(&item, vec2(item_text_x, 12), menu_actions[i].name);
+    const char *name = menu_actions[i].name;
+    if (i == MENU_ACTION_RECORD && recording_dump.active)
+      name = "sending log";
+    else if (i == MENU_ACTION_RECORD && input_log.record != NULL)
+      name = "stop recording";
+    elm_str(&item, vec2(item_text_x, 12), name);
   }
 
   elm_rounded_frame(&items, vec2(0, menu_state.anim.active), DISP_WIDTH,
@@ -390,6 +546,189 @@ static void menu_frame()
           chg_str);
 }
 
+void engine_request_redraw() { g_engine.redraw = true; }
+
+void *engine_alloc(uint32_t size)
+{
+  void *ptr = arena_alloc(&app_arena, size);
+  if (ptr == NULL)
+    printf("engine_alloc: %u bytes don't fit, %u of %u used\n", size,
+           app_arena.used, app_arena.size);
+  return ptr;
+}
+
+// RAM headroom: app arena, heap and stack high-water marks (see memory.h),
+// as telemetry. the arena peak starts over with every report.
+static void report_memory(const char *app)
+{
+  telemetry_memory_t record = {
+      .type = TELEMETRY_RECORD_MEMORY,
+      .version = TELEMETRY_VERSION,
+      .arena_used = app_arena.used,
+      .arena_size = app_arena.size,
+      .arena_peak = app_arena.peak,
+  };
+  snprintf(record.app, sizeof(record.app), "%s", app);
+  // the record is packed, fill it through locals
+  uint32_t heap_peak;
+  record.heap_used = memory_heap_used(&heap_peak);
+  record.heap_peak = heap_peak;
+  for (uint8_t core = 0; core < 2; core++)
+  {
+    uint32_t size;
+    record.stack_peak[core] = memory_stack_peak(core, &size);
+    record.stack_size[core] = size;
+  }
+  telemetry_publish(&record, sizeof(record));
+  arena_reset_peak(&app_arena);
+}
+
+static inline uint16_t sat_u16(uint32_t value)
+{
+  return value > UINT16_MAX ? UINT16_MAX : value;
+}
+
+static_assert(sizeof(((telemetry_input_log_t *)0)->entries[0]) ==
+                  sizeof(input_log_entry_t),
+              "telemetry input log entries are sent as input_log_entry_t");
+
+// send a recorded session a few records at a time, as the ring has room
+static void dump_recording()
+{
+  if (!recording_dump.active)
+    return;
+  if (!recording_dump.started)
+  {
+    telemetry_input_log_start_t start = {
+        .type = TELEMETRY_RECORD_INPUT_LOG_START,
+        .version = TELEMETRY_VERSION,
+        .count = recording.count,
+    };
+    memcpy(start.app, recording.app, sizeof(start.app));
+    if (!telemetry_room(sizeof(start)) ||
+        !telemetry_publish(&start, sizeof(start)))
+      return;
+    recording_dump.started = true;
+  }
+  telemetry_input_log_t chunk = {
+      .type = TELEMETRY_RECORD_INPUT_LOG,
+      .version = TELEMETRY_VERSION,
+  };
+  while (recording_dump.cursor < recording.count &&
+         telemetry_room(sizeof(chunk)))
+  {
+    chunk.first = recording_dump.cursor;
+    chunk.count = MIN(recording.count - recording_dump.cursor,
+                      TELEMETRY_INPUT_LOG_ENTRIES);
+    memcpy(chunk.entries, &recording.entries[chunk.first],
+           chunk.count * sizeof(input_log_entry_t));
+    telemetry_publish(&chunk, sizeof(chunk));
+    recording_dump.cursor += chunk.count;
+  }
+  recording_dump.active = recording_dump.cursor < recording.count;
+}
+
+// once per second stats, as binary telemetry (see telemetry.h)
+static void publish_stats(absolute_time_t now, uint32_t fps)
+{
+  uint32_t frame_avg_us, frame_p99_us, frame_max_us;
+  profile_frame_window(&frame_avg_us, &frame_p99_us, &frame_max_us);
+  audio_stats_snapshot_t synth;
+  audio_stats_read(&g_audio_stats, &synth);
+  peripheral_t *p = &g_engine.peripheral;
+
+  telemetry_stats_t stats = {
+      .type = TELEMETRY_RECORD_STATS,
+      .version = TELEMETRY_VERSION,
+      .time_ms = to_ms_since_boot(now),
+      .fps = sat_u16(fps),
+      .frame_avg_us = sat_u16(frame_avg_us),
+      .frame_p99_us = sat_u16(frame_p99_us),
+      .frame_max_us = sat_u16(frame_max_us),
+      .synth_avg_load = synth.avg_load,
+      .synth_p99_load = synth.p99_load,
+      .synth_peak_load = synth.peak_load,
+      .synth_overruns = sat_u16(synth.overruns),
+      .synth_underruns = sat_u16(synth.underruns),
+      .notes = sat_u16(synth.notes),
+      .note_avg_us = sat_u16(synth.note_avg_us),
+      .note_peak_us = sat_u16(synth.note_peak_us),
+      .battery_level = p->battery_level,
+      .power = (p->plugged_in ? TELEMETRY_POWER_PLUGGED_IN : 0) |
+               (p->charging ? TELEMETRY_POWER_CHARGING : 0),
+      .midi_dropped = sat_u16(g_engine.midi.dropped),
+      .input_dropped = sat_u16(g_input.dropped),
+      .telemetry_dropped = telemetry_dropped(),
+  };
+  telemetry_publish(&stats, sizeof(stats));
+
+#ifdef DEBUG_LOG
+  printf("fps: %d | frame: %d / %d us (p99 %d, max %d) | "
+         "synth: %d%% (p99 %d%%, peak %d%%) | xrun: %d / %d | "
+         "midi: %d notes, %d us (peak %d us)\n",
+         fps, frame_avg_us, TARGET_FRAME_INTERVAL_US, frame_p99_us,
+         frame_max_us, synth.avg_load, synth.p99_load, synth.peak_load,
+         synth.overruns, synth.underruns, synth.notes, synth.note_avg_us,
+         synth.note_peak_us);
+#endif
+}
+
+// advance a tick_n() app. ticks that carry button edges run on their own,
+// the rest of the frame runs in batches. a replay splits batches where its
+// next edge is due.
+static void run_app_ticks(uint32_t ticks)
+{
+  while (ticks > 0)
+  {
+    uint32_t n = ticks;
+    if (g_engine.buttons.left.edge || g_engine.buttons.right.edge)
+      n = 1;
+    else if (input_log.replaying)
+      n = MAX(1, MIN(n, input_log_player_ticks_until(
+                            &input_log.player,
+                            g_engine.uptime_ticks - input_log.start_tick)));
+    g_engine.app->tick_n(n);
+    g_engine.buttons.left.edge = false;
+    g_engine.buttons.right.edge = false;
+    g_engine.tick += n;
+    g_engine.uptime_ticks += n;
+    ticks -= n;
+    // an edge after the last batch would be cleared before any tick saw it,
+    // leave it queued for the next frame
+    if (ticks > 0)
+      apply_input(g_engine.now);
+  }
+}
+
+static bool buttons_active()
+{
+  return g_engine.buttons.left.pressed || g_engine.buttons.left.edge ||
+         g_engine.buttons.right.pressed || g_engine.buttons.right.edge ||
+         g_engine.buttons.menu.pressed || g_engine.buttons.menu.edge;
+}
+
+// frame interval for the current app, capped by its max_fps
+static uint32_t full_frame_interval_us()
+{
+  uint16_t max_fps = g_engine.app->max_fps;
+  if (max_fps == 0 || max_fps >= TARGET_FPS)
+    return TARGET_FRAME_INTERVAL_US;
+  return 1000000 / max_fps;
+}
+
+// sleep until the next idle frame, but wake as soon as input arrives so it
+// doesn't wait for the slow frame.
+static void idle_sleep(uint64_t us)
+{
+  absolute_time_t until = make_timeout_time_us(us);
+  while (!time_reached(until))
+  {
+    if (!input_empty(&g_input))
+      return;
+    sleep_us(MIN(1000, absolute_time_diff_us(get_absolute_time(), until)));
+  }
+}
+
 void engine_run_forever()
 {
   const uint32_t UPDATE_PERIPHERAL_EVERY = 120; // frames
@@ -397,13 +736,9 @@ void engine_run_forever()
   peripheral_set_enabled(&g_engine.peripheral, true);
   peripheral_read_inputs(&g_engine.peripheral);
 
-  TimingInstrumenter ti_tick;
-  TimingInstrumenter ti_show;
-  ti_init(&ti_tick);
-  ti_init(&ti_show);
-
   uint64_t last_frame_us = 0;
   absolute_time_t last_log_us = get_absolute_time();
+  absolute_time_t last_report_us = last_log_us;
   uint32_t last_log_frames = 0;
   uint32_t fps = 0;
 
@@ -417,18 +752,26 @@ void engine_run_forever()
   while (1)
   {
     absolute_time_t now = get_absolute_time();
-    dt = ((uint32_t)absolute_time_diff_us(g_engine.now, now)) + dt;
+    uint32_t elapsed_us = (uint32_t)absolute_time_diff_us(g_engine.now, now);
+    dt = elapsed_us + dt;
     divmod_result_t res = hw_divider_divmod_u32(dt, TICK_INTERVAL_US);
     uint32_t ticks = to_quotient_u32(res);
     dt = to_remainder_u32(res);
     g_engine.now = now;
+    trace_begin(TRACE_FRAME);
 
     // update buttons
-    read_button(&g_engine.buttons.left, now);
-    read_button(&g_engine.buttons.right, now);
-    read_button(&g_engine.buttons.menu, now);
+    trace_begin(TRACE_INPUT);
+    profile_start(PROFILE_INPUT);
+    g_engine.buttons.left.edge = false;
+    g_engine.buttons.right.edge = false;
+    g_engine.buttons.menu.edge = false;
+    apply_input(now);
+    bool input_active = buttons_active();
 
     handle_menu_reset();
+    profile_stop(PROFILE_INPUT);
+    trace_end(TRACE_INPUT);
 
     peripheral_update_counter++;
     if (peripheral_update_counter >= UPDATE_PERIPHERAL_EVERY)
@@ -437,28 +780,59 @@ void engine_run_forever()
       peripheral_update_counter = 0;
     }
 
-    ti_start(&ti_tick);
+    trace_begin(TRACE_TICKS);
+    // animations run on elapsed time, however many ticks run
+    profile_start(PROFILE_ANIM);
+    anim_advance(elapsed_us);
+    profile_stop(PROFILE_ANIM);
 
-    while (ticks--)
+    bool per_tick = !g_engine.paused && g_engine.app->tick_n == NULL &&
+                    g_engine.app->tick != NULL;
+    if (!per_tick)
     {
-      anim_tick(); // always tick animations
-
-      if (!g_engine.paused)
+      // no per-tick app code to interleave with, batch everything
+      if (!g_engine.paused && g_engine.app->tick_n != NULL)
+      {
+        profile_start(PROFILE_TICK);
+        run_app_ticks(ticks);
+        profile_stop(PROFILE_TICK);
+      }
+      else
+      {
+        if (!g_engine.paused)
+          g_engine.tick += ticks;
+        g_engine.uptime_ticks += ticks;
+      }
+    }
+    else
+    {
+      while (ticks--)
       {
         // advance app if not paused
-        if (g_engine.app->tick != NULL)
-        {
-          g_engine.app->tick();
-          // reset button edge. if no tick(), they will instead be reset next
-          // frame
-          g_engine.buttons.left.edge = false;
-          g_engine.buttons.right.edge = false;
-        }
+        profile_start(PROFILE_TICK);
+        g_engine.app->tick();
+        profile_stop(PROFILE_TICK);
+        // reset button edge and take the next queued input. if no tick(),
+        // they will instead be reset next frame
+        g_engine.buttons.left.edge = false;
+        g_engine.buttons.right.edge = false;
         g_engine.tick++; // todo: this should technically be part of the app,
                          // not the engine
+        g_engine.uptime_ticks++;
+        // after the last tick, input waits for the next frame so its edges
+        // reach a tick instead of being cleared first
+        if (ticks > 0)
+        {
+          profile_start(PROFILE_INPUT);
+          apply_input(now);
+          profile_stop(PROFILE_INPUT);
+        }
       }
     }
+    trace_end(TRACE_TICKS);
 
+    trace_begin(TRACE_APP_FRAME);
+    profile_start(PROFILE_FRAME);
     leds_set_all(&g_engine.leds, (color_t){.hex = 0x000000});
     if (!g_engine.paused)
     {
@@ -467,42 +841,72 @@ void engine_run_forever()
       if (g_engine.app->frame != NULL)
         g_engine.app->frame();
     }
+    profile_stop(PROFILE_FRAME);
+    trace_end(TRACE_APP_FRAME);
 
+    trace_begin(TRACE_MENU);
+    profile_start(PROFILE_MENU);
     menu_frame();
+    profile_stop(PROFILE_MENU);
+    trace_end(TRACE_MENU);
 
-    ti_stop(&ti_tick);
 #ifdef DEBUG_FPS
     draw_fps(u8g2, fps);
 #endif
 
-    ti_start(&ti_show);
-    // write display
-    u8g2_SendBuffer(u8g2);
+    // write display, only the tiles that changed
+    trace_begin(TRACE_DISPLAY);
+    profile_start(PROFILE_DISPLAY);
+    bool screen_changed = display_send_buffer(&g_engine.display);
+    profile_stop(PROFILE_DISPLAY);
+    trace_end(TRACE_DISPLAY);
     // write LEDs
+    trace_begin(TRACE_LEDS);
+    profile_start(PROFILE_LEDS);
     leds_show(&g_engine.leds);
-    ti_stop(&ti_show);
+    profile_stop(PROFILE_LEDS);
+    trace_end(TRACE_LEDS);
+    profile_commit_frame();
+    trace_flush();
+    dump_recording();
+    telemetry_drain();
 
     // log fps and frame limit
     last_log_frames++;
     if (absolute_time_diff_us(last_log_us, now) > 1000000)
     {
       fps = last_log_frames;
-      float ti_tick_avg = ti_get_average_ms(&ti_tick, true);
-      float ti_show_avg = ti_get_average_ms(&ti_show, true);
-      float ti_frame_avg = ti_tick_avg + ti_show_avg;
-      printf(
-          "fps: %d | frame: %.2f / %.2f ms | tick: %.2f ms | show: %.2f ms\n",
-          fps, ti_frame_avg, TARGET_FRAME_INTERVAL_US / 1000.0f, ti_tick_avg,
-          ti_show_avg);
+      publish_stats(now, fps);
       last_log_us = now;
       last_log_frames = 0;
     }
+    if (absolute_time_diff_us(last_report_us, now) > PROFILE_REPORT_INTERVAL_US)
+    {
+      profile_report(g_engine.app->name);
+      report_memory(g_engine.app->name);
+      last_report_us = now;
+    }
+
+    // full frame rate while anything moves, idle rate on static screens
+    if (input_active || screen_changed || g_engine.redraw || anim_any_active())
+      g_engine.active_until = delayed_by_us(now, IDLE_AFTER_US);
+    g_engine.redraw = false;
+    bool idle = time_reached(g_engine.active_until);
+    uint32_t frame_interval_us = full_frame_interval_us();
+    if (idle)
+      frame_interval_us = MAX(frame_interval_us, IDLE_FRAME_INTERVAL_US);
 
+    trace_end(TRACE_FRAME);
     now = get_absolute_time(); // update timestamp for frame limit calc
     uint64_t spent_us = absolute_time_diff_us(last_frame_us, now);
-    if (spent_us < TARGET_FRAME_INTERVAL_US)
+    if (spent_us < frame_interval_us)
     {
-      sleep_us(TARGET_FRAME_INTERVAL_US - spent_us);
+      trace_begin(TRACE_SLEEP);
+      if (idle)
+        idle_sleep(frame_interval_us - spent_us);
+      else
+        sleep_us(frame_interval_us - spent_us);
+      trace_end(TRACE_SLEEP);
       last_frame_us = get_absolute_time();
     }
     else
@@ -514,10 +918,19 @@ void engine_run_forever()
 
 void engine_set_app(app_t *app)
 {
+  if (g_engine.app != NULL)
+  {
+    // close the leaving app's profile
+    profile_report(g_engine.app->name);
+    report_memory(g_engine.app->name);
+  }
   if (g_engine.app != NULL && g_engine.app->leave != NULL)
   {
+    trace_begin(TRACE_APP_LEAVE);
     g_engine.app->leave();
+    trace_end(TRACE_APP_LEAVE);
   }
+  arena_reset(&app_arena);
   anim_sys_clear_all();
   reset_buttons(false);
 
@@ -529,19 +942,67 @@ void engine_set_app(app_t *app)
   g_engine.tick = 0;
   g_engine.app = app;
   g_engine.paused = false;
+  g_engine.redraw = true;
 
-  // reset audio synth
+  // reset audio synth. panic under the synth's lock, core1 may be in the
+  // middle of the sequencer or tune player it stops (reset_voices locks itself)
+  mutex_enter_blocking(&g_engine.synth.mutex);
   audio_synth_panic(&g_engine.synth);
+  mutex_exit(&g_engine.synth.mutex);
   audio_synth_reset_voices(&g_engine.synth);
-  // seed based on time
-  srand(to_ms_since_boot(get_absolute_time()));
+  audio_analysis_set_enabled(&g_engine.synth.analysis, false);
+  // seed based on time, or as recorded
+  uint32_t seed = to_ms_since_boot(get_absolute_time());
+  if (input_log.replaying)
+    input_log_player_seed(&input_log.player, &seed);
+  if (input_log.record != NULL)
+    input_log_record(input_log.record,
+                     g_engine.uptime_ticks - input_log.start_tick,
+                     INPUT_LOG_SEED, false, seed);
+  srand(seed);
 
   if (g_engine.app != NULL && g_engine.app->enter != NULL)
   {
+    trace_begin(TRACE_APP_ENTER);
     g_engine.app->enter();
+    trace_end(TRACE_APP_ENTER);
   }
 }
 
+static void start_input_log()
+{
+  input_log.start = get_absolute_time();
+  input_log.start_tick = g_engine.uptime_ticks;
+}
+
+void engine_record_start(input_log_t *log, app_t *app)
+{
+  input_log.replaying = false;
+  start_input_log();
+  input_log_record_start(log, app != NULL ? app->name : NULL, 0);
+  input_log.record = log;
+  engine_set_app(app);
+}
+
+void engine_record_stop()
+{
+  input_log.record = NULL;
+}
+
+void engine_replay_start(const input_log_t *log, app_t *app)
+{
+  input_log.record = NULL;
+  start_input_log();
+  input_log_player_start(&input_log.player, log, 0);
+  input_log.replaying = true;
+  engine_set_app(app);
+}
+
+bool engine_replay_active()
+{
+  return input_log.replaying;
+}
+
 void engine_pause()
 {
   if (g_engine.paused)
@@ -4,21 +4,30 @@
 
 #include <shared/utils/q1x15.h>
 
+#include "audio/midi.h"
 #include "audio/playback.h"
 #include "audio/synth.h"
 #include "display.h"
+#include "input_log.h"
 #include "leds.h"
 #include "peripheral.h"
+#include "sprite.h"
 
 typedef struct
 {
-  char name[32];       // app name
-  const uint8_t *icon; // app icon
+  char name[32];        // app name
+  const sprite_t *icon; // app icon, 36x36
+  uint16_t max_fps;     // frame rate cap, 0 = TARGET_FPS
 
   // called when scene is entered. called after exit of previous scene.
+  // apps play on synth voices below MIDI_INPUT_FIRST_VOICE.
   void (*enter)(void);
   // called every tick
   void (*tick)(void);
+  // optional, replaces tick(): advance n ticks at once. button edges are
+  // only set in a call with n == 1, so they are still seen by exactly one
+  // tick. animations are advanced for the whole batch before the call.
+  void (*tick_n)(uint32_t n);
   // called every frame
   void (*frame)(void);
   // called when scene is paused (sleep or menu)
@@ -41,6 +50,9 @@ typedef struct
 {
   button_id_t id;
   absolute_time_t pressed_at;
+  absolute_time_t edge_at;      // exact time of the last transition
+  absolute_time_t prev_edge_at; // exact time of the transition before it
+  absolute_time_t reset_at;     // input from before this time is dropped
   bool pressed; // true if button is currently pressed
   bool edge;    // true if button was just transitioned this frame. will
                 // automatically be reset next tick or frame
@@ -50,6 +62,7 @@ typedef struct
 typedef struct
 {
   audio_synth_t synth;
+  audio_synth_midi_t midi; // external MIDI input, see midi_input.h
   display_t display;
   leds_t leds;
   peripheral_t peripheral;
@@ -62,10 +75,14 @@ typedef struct
 
   absolute_time_t now;
   uint32_t tick;
+  uint32_t uptime_ticks; // all ticks run, paused or not. input log position
 
   bool paused;
   app_t *app;
 
+  bool redraw;                 // app asked for a full rate frame
+  absolute_time_t active_until; // full frame rate until then, idle after
+
   uint8_t volume;
 } engine_t;
 
@@ -81,6 +98,20 @@ void engine_pause();
 void engine_resume();
 void engine_set_volume(int8_t level);
 void engine_change_volume(int8_t direction);
+// record button input and rand() seeds into log, starting with a fresh
+// engine_set_app(app). see input_log.h
+void engine_record_start(input_log_t *log, app_t *app);
+void engine_record_stop();
+// replay a recorded log from a fresh engine_set_app(app). live button input is
+// ignored until the log runs out.
+void engine_replay_start(const input_log_t *log, app_t *app);
+bool engine_replay_active();
+// keep the frame rate up for visuals the engine can't see (e.g. not driven
+// by anim or input). without it, static screens drop to IDLE_FPS.
+void engine_request_redraw();
+// zeroed memory for the running app, freed when the app changes. NULL once
+// APP_ARENA_SIZE is used up. use in enter(), not per frame.
+void *engine_alloc(uint32_t size);
 
 static inline button_t *engine_button_from_id(button_id_t button_id)
 {
@@ -109,6 +140,17 @@ static inline bool engine_button_keyup(button_id_t button_id)
   return !button->pressed && button->edge;
 }
 
+// time between the last two transitions of a button, i.e. the exact length of
+// the press (on keyup) or of the gap before it (on keydown). 0 if unknown.
+static inline uint32_t engine_button_edge_interval_us(button_id_t button_id)
+{
+  button_t *button = engine_button_from_id(button_id);
+  if (is_nil_time(button->prev_edge_at))
+    return 0;
+  return (uint32_t)absolute_time_diff_us(button->prev_edge_at,
+                                         button->edge_at);
+}
+
 static inline bool engine_button_pressed(button_id_t button_id)
 {
   button_t *button = engine_button_from_id(button_id);
@@ -147,20 +189,21 @@ static inline button_id_t engine_button_get_pressed_first()
 static const int32_t ENGINE_BUTTON_HOLD_MS_TRIGGER = 300;
 static const int32_t ENGINE_BUTTON_HOLD_MS_CONFIRM = 1200;
 
-static inline float engine_button_held_ratio(button_id_t button_id)
+// how far a hold is from triggering to confirming, Q16.16 (0..65536)
+static inline uint32_t engine_button_held_q16(button_id_t button_id)
 {
+  const int32_t span =
+      ENGINE_BUTTON_HOLD_MS_CONFIRM - ENGINE_BUTTON_HOLD_MS_TRIGGER;
   button_t *button = engine_button_from_id(button_id);
   if (!button->pressed)
-    return 0.f;
+    return 0;
   int32_t ms = absolute_time_diff_us(button->pressed_at, g_engine.now) / 1000;
-  float held =
-      (ms - ENGINE_BUTTON_HOLD_MS_TRIGGER) /
-      (float)(ENGINE_BUTTON_HOLD_MS_CONFIRM - ENGINE_BUTTON_HOLD_MS_TRIGGER);
-  if (held < 0.f)
-    held = 0.f;
-  if (held > 1.f)
-    held = 1.f;
-  return held;
+  ms -= ENGINE_BUTTON_HOLD_MS_TRIGGER;
+  if (ms <= 0)
+    return 0;
+  if (ms >= span)
+    return 65536;
+  return ((uint32_t)ms << 16) / span;
 }
 
 typedef struct
@@ -0,0 +1,3 @@
+#include "input.h"
+
+input_queue_t g_input;
@@ -0,0 +1,65 @@
+// Timestamped button events.
+// The platform pushes debounced press/release events with their exact time
+// (GPIO IRQ on rp2, SDL key events on host) and the engine derives button_t
+// state from them, so edges are never lost or late by a frame.
+//
+// Single producer (IRQ context on core0, or the host event loop), single
+// consumer (engine loop). Lock-free; a full queue drops new events.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <hardware/sync.h>
+#include <pico/time.h>
+
+#define INPUT_QUEUE_SIZE 32 // power of two
+
+typedef struct {
+  absolute_time_t time; // time of the (first) edge
+  uint8_t button;       // button_id_t
+  bool pressed;
+} input_event_t;
+
+typedef struct {
+  input_event_t events[INPUT_QUEUE_SIZE];
+  volatile uint32_t head; // written by the producer
+  volatile uint32_t tail; // written by the consumer
+  volatile uint32_t dropped;
+} input_queue_t;
+
+extern input_queue_t g_input;
+
+static inline bool input_empty(const input_queue_t *q) {
+  return q->head == q->tail;
+}
+
+// producer side
+static inline bool input_push(input_queue_t *q, const input_event_t *event) {
+  uint32_t head = q->head;
+  if (head - q->tail >= INPUT_QUEUE_SIZE) {
+    q->dropped = q->dropped + 1;
+    return false;
+  }
+  q->events[head % INPUT_QUEUE_SIZE] = *event;
+  __dmb();
+  q->head = head + 1;
+  return true;
+}
+
+// consumer side: look at the oldest event without removing it
+static inline bool input_peek(const input_queue_t *q, input_event_t *out) {
+  uint32_t tail = q->tail;
+  if (q->head == tail)
+    return false;
+  __dmb();
+  *out = q->events[tail % INPUT_QUEUE_SIZE];
+  return true;
+}
+
+// consumer side: remove the oldest event
+static inline void input_pop(input_queue_t *q) {
+  __dmb();
+  q->tail = q->tail + 1;
+}
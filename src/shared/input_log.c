@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "input_log.h"
+
+void input_log_record_start(input_log_t *log, const char *app, uint32_t tick) {
+  snprintf(log->app, sizeof(log->app), "%s", app != NULL ? app : "");
+  log->count = 0;
+  log->tick = tick;
+  log->overflow = false;
+}
+
+static bool append(input_log_t *log, uint16_t delta, uint8_t button,
+                   bool pressed, uint32_t time_us) {
+  if (log->count >= log->capacity) {
+    log->overflow = true;
+    return false;
+  }
+  log->entries[log->count++] = (input_log_entry_t){
+      .delta = delta,
+      .button = button,
+      .pressed = pressed,
+      .time_us = time_us,
+  };
+  return true;
+}
+
+bool input_log_record(input_log_t *log, uint32_t tick, uint8_t button,
+                      bool pressed, uint32_t time_us) {
+  if (log->overflow)
+    return false;
+  uint32_t delta = tick - log->tick;
+  while (delta > UINT16_MAX) {
+    if (!append(log, UINT16_MAX, INPUT_LOG_WAIT, false, 0))
+      return false;
+    delta -= UINT16_MAX;
+  }
+  if (!append(log, delta, button, pressed, time_us))
+    return false;
+  log->tick = tick;
+  return true;
+}
+
+void input_log_player_start(input_log_player_t *player, const input_log_t *log,
+                            uint32_t tick) {
+  player->log = log;
+  player->cursor = 0;
+  player->seed_cursor = 0;
+  player->next_tick = tick;
+  if (log->count > 0)
+    player->next_tick += log->entries[0].delta;
+}
+
+static void advance(input_log_player_t *player) {
+  player->cursor++;
+  if (!input_log_player_done(player))
+    player->next_tick += player->log->entries[player->cursor].delta;
+}
+
+bool input_log_player_peek(input_log_player_t *player, uint32_t tick,
+                           input_log_entry_t *out) {
+  while (!input_log_player_done(player) &&
+         (int32_t)(tick - player->next_tick) >= 0) {
+    const input_log_entry_t *entry = &player->log->entries[player->cursor];
+    if (entry->button != INPUT_LOG_SEED && entry->button != INPUT_LOG_WAIT) {
+      *out = *entry;
+      return true;
+    }
+    advance(player);
+  }
+  return false;
+}
+
+void input_log_player_pop(input_log_player_t *player) {
+  if (!input_log_player_done(player))
+    advance(player);
+}
+
+uint32_t input_log_player_ticks_until(const input_log_player_t *player,
+                                      uint32_t tick) {
+  if (input_log_player_done(player))
+    return UINT32_MAX;
+  int32_t ticks = (int32_t)(player->next_tick - tick);
+  return ticks > 0 ? (uint32_t)ticks : 0;
+}
+
+bool input_log_player_seed(input_log_player_t *player, uint32_t *seed) {
+  const input_log_t *log = player->log;
+  while (player->seed_cursor < log->count) {
+    const input_log_entry_t *entry = &log->entries[player->seed_cursor++];
+    if (entry->button == INPUT_LOG_SEED) {
+      *seed = entry->time_us;
+      return true;
+    }
+  }
+  return false;
+}
+
+#if !PICO_ON_DEVICE
+// file layout: "ILOG", app name, entry count, entries (all little endian)
+static const char INPUT_LOG_MAGIC[4] = {'I', 'L', 'O', 'G'};
+
+bool input_log_save(const input_log_t *log, const char *path) {
+  FILE *f = fopen(path, "wb");
+  if (f == NULL)
+    return false;
+  bool ok = fwrite(INPUT_LOG_MAGIC, sizeof(INPUT_LOG_MAGIC), 1, f) == 1 &&
+            fwrite(log->app, sizeof(log->app), 1, f) == 1 &&
+            fwrite(&log->count, sizeof(log->count), 1, f) == 1 &&
+            fwrite(log->entries, sizeof(input_log_entry_t), log->count, f) ==
+                log->count;
+  return fclose(f) == 0 && ok;
+}
+
+bool input_log_load(input_log_t *log, const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (f == NULL)
+    return false;
+  char magic[sizeof(INPUT_LOG_MAGIC)];
+  uint32_t count = 0;
+  bool ok = fread(magic, sizeof(magic), 1, f) == 1 &&
+            memcmp(magic, INPUT_LOG_MAGIC, sizeof(magic)) == 0 &&
+            fread(log->app, sizeof(log->app), 1, f) == 1 &&
+            fread(&count, sizeof(count), 1, f) == 1 &&
+            count <= log->capacity &&
+            fread(log->entries, sizeof(input_log_entry_t), count, f) == count;
+  fclose(f);
+  log->app[sizeof(log->app) - 1] = '\0';
+  log->count = ok ? count : 0;
+  log->tick = 0;
+  log->overflow = false;
+  return ok;
+}
+#endif
@@ -0,0 +1,84 @@
+// Button input log, for recording a session and replaying it exactly.
+//
+// While recording, the engine logs every button edge it applies together with
+// the engine tick it was applied on, and every rand() seed it picks in
+// engine_set_app(). Replaying applies the same edges on the same ticks and
+// reuses the seeds, so an app runs the same session again without anyone
+// pressing buttons (see engine_record_start() / engine_replay_start()).
+// "record" in the engine menu records a session in the running app and, once
+// stopped, sends the log over telemetry; scripts/telemetry.py --input-log
+// saves it for mck-parting-c-headless --replay.
+// the menu reads its button once per frame, so input to the menu lands on the
+// same frame rather than the same tick.
+//
+// Each entry waits `delta` engine ticks after the previous one, then:
+//   button != 0          edge of that button_id_t, `time_us` is the exact
+//                        edge time relative to the start of the recording
+//   INPUT_LOG_SEED       rand() seed of the next engine_set_app(), in time_us
+//   INPUT_LOG_WAIT       nothing, used to extend long gaps
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define INPUT_LOG_SEED 0xfe
+#define INPUT_LOG_WAIT 0xff
+
+typedef struct {
+  uint16_t delta; // ticks since the previous entry
+  uint8_t button; // button_id_t, INPUT_LOG_SEED or INPUT_LOG_WAIT
+  uint8_t pressed;
+  uint32_t time_us;
+} input_log_entry_t;
+
+typedef struct {
+  char app[32]; // name of the app the recording started in
+  input_log_entry_t *entries;
+  uint32_t capacity;
+  uint32_t count;
+  uint32_t tick; // tick of the last entry, while recording
+  bool overflow; // ran out of entries while recording
+} input_log_t;
+
+typedef struct {
+  const input_log_t *log;
+  uint32_t cursor;      // next entry to apply
+  uint32_t next_tick;   // tick of the entry at cursor
+  uint32_t seed_cursor; // next entry to look for a seed at
+} input_log_player_t;
+
+// start a new recording in the log's buffer. `tick` is the engine tick the
+// recording starts on.
+void input_log_record_start(input_log_t *log, const char *app, uint32_t tick);
+
+// append an entry on `tick`. returns false if the log is full.
+bool input_log_record(input_log_t *log, uint32_t tick, uint8_t button,
+                      bool pressed, uint32_t time_us);
+
+void input_log_player_start(input_log_player_t *player, const input_log_t *log,
+                            uint32_t tick);
+
+// true once every entry has been applied
+static inline bool input_log_player_done(const input_log_player_t *player) {
+  return player->cursor >= player->log->count;
+}
+
+// the next edge due on or before `tick`, skipping seeds and waits. it stays
+// the next one until input_log_player_pop() is called.
+bool input_log_player_peek(input_log_player_t *player, uint32_t tick,
+                           input_log_entry_t *out);
+void input_log_player_pop(input_log_player_t *player);
+
+// ticks from `tick` until the next entry is due, UINT32_MAX when done
+uint32_t input_log_player_ticks_until(const input_log_player_t *player,
+                                      uint32_t tick);
+
+// the next recorded seed, in order. returns false if there is none left.
+bool input_log_player_seed(input_log_player_t *player, uint32_t *seed);
+
+#if !PICO_ON_DEVICE
+// host only: store a log in a file / load it into the log's buffer
+bool input_log_save(const input_log_t *log, const char *path);
+bool input_log_load(input_log_t *log, const char *path);
+#endif
@@ -0,0 +1,19 @@
+// RAM use, for knowing the headroom left.
+// Stacks are painted with a pattern at startup and the deepest overwritten
+// word gives the high-water mark. The heap reports what the C library has
+// handed out. Platforms without fixed stacks or a fixed heap report 0.
+
+#pragma once
+
+#include <stdint.h>
+
+#define MEMORY_STACK_PATTERN 0x5354434bu // "STCK"
+
+// paint the calling core's unused stack. call first thing on each core.
+void memory_paint_stack();
+
+// deepest stack use so far on a core in bytes, and the stack's size
+uint32_t memory_stack_peak(uint8_t core, uint32_t *size);
+
+// heap bytes in use, and the most the heap has grown to
+uint32_t memory_heap_used(uint32_t *peak);
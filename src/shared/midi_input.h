@@ -0,0 +1,11 @@
+// HAL for external MIDI input feeding the synth
+
+#pragma once
+
+#include "audio/midi.h"
+
+// start delivering MIDI bytes into `midi`.
+// - device: reads the USB stdio channel (see MIDI_INPUT_USB_STDIO)
+// - host: `source` is a path to a named pipe, a raw MIDI stream or a standard
+//   MIDI file ("-" for stdin). NULL disables input.
+void midi_input_init(audio_synth_midi_t *midi, const char *source);
@@ -0,0 +1,69 @@
+#include <stdio.h>
+
+#include <shared/utils/timing.h>
+
+#include "profile.h"
+#include "telemetry.h"
+
+#if PROFILE_ENABLED
+
+profile_frame_t g_profile_frame;
+
+static TimingInstrumenter sections[PROFILE_SECTION_COUNT];
+static TimingInstrumenter frame_window; // total, for the per second log
+
+void profile_init() {
+  for (int i = 0; i < PROFILE_SECTION_COUNT; i++)
+    ti_enable_histogram(&sections[i]);
+  ti_enable_histogram(&frame_window);
+}
+
+void profile_commit_frame() {
+  uint32_t total = 0;
+  for (int i = 0; i < PROFILE_TOTAL; i++) {
+    total += g_profile_frame.frame_us[i];
+    ti_record(&sections[i], g_profile_frame.frame_us[i]);
+    g_profile_frame.frame_us[i] = 0;
+  }
+  ti_record(&sections[PROFILE_TOTAL], total);
+  ti_record(&frame_window, total);
+}
+
+static uint16_t sat_u16(uint32_t value) {
+  return value > UINT16_MAX ? UINT16_MAX : value;
+}
+
+void profile_report(const char *app) {
+  if (sections[PROFILE_TOTAL].count == 0)
+    return;
+  telemetry_profile_t record = {
+      .type = TELEMETRY_RECORD_PROFILE,
+      .version = TELEMETRY_VERSION,
+  };
+  snprintf(record.app, sizeof(record.app), "%s", app);
+  for (int i = 0; i < PROFILE_SECTION_COUNT; i++) {
+    TimingInstrumenter *ti = &sections[i];
+    record.section = i;
+    record.frames = sat_u16(ti->count);
+    record.min_us = sat_u16(ti->min_us);
+    record.avg_us = sat_u16((uint32_t)(ti->aggregate_time / ti->count));
+    record.p50_us = sat_u16(ti_get_percentile_us(ti, 50));
+    record.p95_us = sat_u16(ti_get_percentile_us(ti, 95));
+    record.p99_us = sat_u16(ti_get_percentile_us(ti, 99));
+    record.max_us = sat_u16(ti->max_us);
+    telemetry_publish(&record, sizeof(record));
+    ti_init(ti);
+  }
+}
+
+void profile_frame_window(uint32_t *avg_us, uint32_t *p99_us,
+                          uint32_t *max_us) {
+  *avg_us = frame_window.count
+                ? (uint32_t)(frame_window.aggregate_time / frame_window.count)
+                : 0;
+  *p99_us = ti_get_percentile_us(&frame_window, 99);
+  *max_us = frame_window.count ? frame_window.max_us : 0;
+  ti_init(&frame_window);
+}
+
+#endif
@@ -0,0 +1,77 @@
+// Frame profiler.
+// The engine times each section of its frame, sums a section over the frame
+// (anim and app tick run once per tick) and records the sums in histogram
+// instrumenters (utils/timing.h). A report gives min, avg, p50/p95/p99 and max
+// per section for the app that was active. Reports go out as telemetry
+// records (telemetry.h) every PROFILE_REPORT_INTERVAL_US and when the app
+// changes. It takes two timer reads per section, cheap enough to leave on.
+// PROFILE_ENABLED 0 compiles it out.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <pico/time.h>
+
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED 1
+#endif
+
+#define PROFILE_REPORT_INTERVAL_US 10000000
+
+// keep in sync with PROFILE_SECTIONS in scripts/telemetry.py
+typedef enum {
+  PROFILE_INPUT,   // button input and menu reset
+  PROFILE_ANIM,    // anim_advance()
+  PROFILE_TICK,    // app tick()
+  PROFILE_FRAME,   // app frame()
+  PROFILE_MENU,    // menu_frame()
+  PROFILE_DISPLAY, // display send
+  PROFILE_LEDS,    // LED show
+  PROFILE_TOTAL,   // all of the above
+  PROFILE_SECTION_COUNT,
+} profile_section_t;
+
+#if PROFILE_ENABLED
+
+typedef struct {
+  absolute_time_t started[PROFILE_SECTION_COUNT];
+  uint32_t frame_us[PROFILE_SECTION_COUNT]; // this frame so far
+} profile_frame_t;
+
+extern profile_frame_t g_profile_frame;
+
+static inline void profile_start(profile_section_t section) {
+  g_profile_frame.started[section] = get_absolute_time();
+}
+
+static inline void profile_stop(profile_section_t section) {
+  g_profile_frame.frame_us[section] += (uint32_t)absolute_time_diff_us(
+      g_profile_frame.started[section], get_absolute_time());
+}
+
+void profile_init();
+// record this frame's section times
+void profile_commit_frame();
+// publish the report for `app` and start over
+void profile_report(const char *app);
+// average, p99 and worst frame work time since the last call, for the per
+// second log
+void profile_frame_window(uint32_t *avg_us, uint32_t *p99_us,
+                          uint32_t *max_us);
+
+#else
+
+static inline void profile_start(profile_section_t section) {}
+static inline void profile_stop(profile_section_t section) {}
+static inline void profile_init() {}
+static inline void profile_commit_frame() {}
+static inline void profile_report(const char *app) {}
+static inline void profile_frame_window(uint32_t *avg_us, uint32_t *p99_us,
+                                        uint32_t *max_us) {
+  *avg_us = 0;
+  *p99_us = 0;
+  *max_us = 0;
+}
+
+#endif
@@ -0,0 +1,214 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "config.h"
+#include "sprite.h"
+
+// combine n column bytes into a buffer row, within the rows' bit mask
+static void blit_row(uint8_t *dst, const uint8_t *src, uint16_t n,
+                     uint8_t mask, sprite_mode_t mode) {
+  switch (mode) {
+  case SPRITE_COPY:
+    if (mask == 0xff) {
+      memcpy(dst, src, n);
+      break;
+    }
+    for (uint16_t i = 0; i < n; i++)
+      dst[i] = (dst[i] & ~mask) | (src[i] & mask);
+    break;
+  case SPRITE_OR:
+    for (uint16_t i = 0; i < n; i++)
+      dst[i] |= src[i] & mask;
+    break;
+  case SPRITE_CLEAR:
+    for (uint16_t i = 0; i < n; i++)
+      dst[i] &= ~(src[i] & mask);
+    break;
+  case SPRITE_XOR:
+    for (uint16_t i = 0; i < n; i++)
+      dst[i] ^= src[i] & mask;
+    break;
+  }
+}
+
+// reads an RLE stream (see sprite_t) in order
+typedef struct {
+  const uint8_t *p;
+  uint8_t left; // bytes left of the current run or literal
+  bool run;
+} rle_t;
+
+// the next n bytes into out, or skip them if out is NULL
+static void rle_read(rle_t *rle, uint8_t *out, uint16_t n) {
+  while (n > 0) {
+    if (rle->left == 0) {
+      uint8_t c = *rle->p++;
+      rle->run = c & 0x80;
+      rle->left = rle->run ? (c & 0x7f) + 2 : c + 1;
+    }
+    uint16_t m = n < rle->left ? n : rle->left;
+    if (rle->run) {
+      if (out != NULL)
+        memset(out, *rle->p, m);
+      if (rle->left == m)
+        rle->p++; // past the repeated byte
+    } else {
+      if (out != NULL)
+        memcpy(out, rle->p, m);
+      rle->p += m;
+    }
+    if (out != NULL)
+      out += m;
+    rle->left -= m;
+    n -= m;
+  }
+}
+
+void sprite_draw(u8g2_t *u8g2, int16_t x, int16_t y, const sprite_t *sprite,
+                 sprite_mode_t mode) {
+  uint8_t *buf = u8g2_GetBufferPtr(u8g2);
+  int16_t buf_width = u8g2_GetBufferTileWidth(u8g2) * 8;
+  int16_t buf_rows = u8g2_GetBufferTileHeight(u8g2);
+
+  // clip columns
+  int16_t x0 = x < 0 ? 0 : x;
+  int16_t x1 = x + sprite->width;
+  if (x1 > buf_width)
+    x1 = buf_width;
+  if (x0 >= x1)
+    return;
+  uint16_t n = x1 - x0;
+  if (n > DISP_WIDTH)
+    n = DISP_WIDTH; // room in the row buffers, the buffer is never wider
+
+  // y >> 3 rounds down for negative y too, y & 7 is then the shift
+  uint8_t shift = y & 7;
+  int16_t first_row = (y >> 3) - u8g2->tile_curr_row;
+  uint8_t rows = (shift + sprite->height + 7) / 8;
+  uint8_t aligned_rows = (sprite->height + 7) / 8;
+  rle_t rle = {.p = sprite->bits};
+
+  if (sprite->compressed && mode == SPRITE_COPY && shift == 0 && x == 0 &&
+      sprite->width == buf_width && sprite->height % 8 == 0 &&
+      first_row == 0 && rows <= buf_rows) {
+    // covers whole buffer rows, decode right into them
+    rle_read(&rle, buf, rows * buf_width);
+    return;
+  }
+
+  const uint8_t *bits = sprite->bits + (x0 - x);
+  if (sprite->shifts > 1)
+    bits += shift * sprite->rows * sprite->width;
+
+  uint8_t decoded[2][DISP_WIDTH];
+  uint8_t shifted[DISP_WIDTH];
+  const uint8_t *above = NULL;
+  for (uint8_t k = 0; k < rows; k++) {
+    int16_t row = first_row + k;
+    if (row >= buf_rows)
+      break;
+
+    // row k of the variant to draw: pre-shifted, or aligned
+    const uint8_t *src = NULL;
+    if (!sprite->compressed) {
+      src = bits + k * sprite->width;
+    } else if (k < aligned_rows) {
+      // decoded even above the buffer, the stream only goes forwards
+      src = decoded[k & 1];
+      rle_read(&rle, NULL, x0 - x);
+      rle_read(&rle, decoded[k & 1], n);
+      rle_read(&rle, NULL, sprite->width - (x0 - x) - n);
+    }
+
+    if (row >= 0) {
+      // the bits of this row the sprite covers
+      int16_t end = shift + sprite->height - k * 8;
+      uint8_t mask = k == 0 ? 0xff << shift : 0xff;
+      if (end < 8)
+        mask &= 0xff >> (8 - end);
+
+      const uint8_t *out = src;
+      if (shift != 0 && sprite->shifts == 1) {
+        // low bits from the aligned row k, high bits from the one above
+        memset(shifted, 0, n);
+        if (k < aligned_rows)
+          for (uint16_t i = 0; i < n; i++)
+            shifted[i] = src[i] << shift;
+        if (k > 0)
+          for (uint16_t i = 0; i < n; i++)
+            shifted[i] |= above[i] >> (8 - shift);
+        out = shifted;
+      }
+      blit_row(buf + row * buf_width + x0, out, n, mask, mode);
+    }
+    above = sprite->compressed ? src : bits + k * sprite->width;
+  }
+}
+
+// XOR a delta into rows of `width` bytes, moved right by x columns and down by
+// first_row rows and shift bits. XOR works byte by byte, so a shifted byte
+// splits across two rows like any other.
+static void xor_delta(uint8_t *dst, int16_t width, int16_t rows, int16_t x,
+                      int16_t first_row, uint8_t shift, const uint8_t *delta) {
+  while (delta[0] != SPRITE_DELTA_END) {
+    int16_t row = first_row + delta[0];
+    int16_t col = x + delta[1];
+    uint8_t n = delta[2];
+    const uint8_t *bytes = delta + 3;
+    delta += 3 + n;
+    for (uint8_t i = 0; i < n; i++, col++) {
+      if (col < 0 || col >= width)
+        continue;
+      if (row >= 0 && row < rows)
+        dst[row * width + col] ^= bytes[i] << shift;
+      if (shift != 0 && row + 1 >= 0 && row + 1 < rows)
+        dst[(row + 1) * width + col] ^= bytes[i] >> (8 - shift);
+    }
+  }
+}
+
+void sprite_anim_draw(u8g2_t *u8g2, int16_t x, int16_t y,
+                      const sprite_anim_t *anim, uint8_t frame) {
+  sprite_draw(u8g2, x, y, anim->key, SPRITE_COPY);
+  xor_delta(u8g2_GetBufferPtr(u8g2), u8g2_GetBufferTileWidth(u8g2) * 8,
+            u8g2_GetBufferTileHeight(u8g2), x,
+            (y >> 3) - u8g2->tile_curr_row, y & 7, anim->deltas[frame]);
+}
+
+void sprite_player_init(sprite_player_t *player, const sprite_anim_t *anim) {
+  const sprite_t *key = anim->key;
+  uint16_t size = (key->height + 7) / 8 * key->width;
+  assert(size <= sizeof(player->cache));
+
+  // the aligned variant comes first when there are more
+  if (key->compressed) {
+    rle_t rle = {.p = key->bits};
+    rle_read(&rle, player->cache, size);
+  } else {
+    memcpy(player->cache, key->bits, size);
+  }
+  player->anim = anim;
+  player->frame = 0;
+  player->sprite = (sprite_t){
+      .width = key->width,
+      .height = key->height,
+      .rows = (key->height + 7) / 8,
+      .shifts = 1,
+      .bits = player->cache,
+  };
+  xor_delta(player->cache, key->width, player->sprite.rows, 0, 0, 0,
+            anim->deltas[0]);
+}
+
+void sprite_player_set_frame(sprite_player_t *player, uint8_t frame) {
+  if (frame == player->frame)
+    return;
+  // back to the key frame, then on to the new one
+  const sprite_anim_t *anim = player->anim;
+  xor_delta(player->cache, player->sprite.width, player->sprite.rows, 0, 0, 0,
+            anim->deltas[player->frame]);
+  xor_delta(player->cache, player->sprite.width, player->sprite.rows, 0, 0, 0,
+            anim->deltas[frame]);
+  player->frame = frame;
+}
@@ -0,0 +1,85 @@
+// 1bpp sprites in the display buffer's own layout.
+// scripts/bake.py turns the XBM images of an app's assets.h into sprites
+// (<app>/sprites.h): rows of 8 pixels, one byte per column, bit 0 at the top,
+// as in u8g2's vertical-top-lsb tile buffer. Drawing copies or combines whole
+// bytes into the buffer instead of going through u8g2's per-pixel-line XBM
+// drawing; a full-screen image at an aligned y is a memcpy per row.
+//
+// Sprites that move vertically (tagged "moving" in Aseprite) are baked once
+// per y % 8, shifted down by that many pixels, so unaligned draws need no
+// shifting either. The rest only get the aligned variant and are shifted
+// while drawing.
+//
+// Full-screen images are stored RLE compressed instead (mostly zeros, about a
+// third of the size) and decoded row by row as they are drawn, or straight
+// into the buffer when they cover it entirely.
+//
+// Frames of one Aseprite file of the same size are baked as an animation
+// instead: one aligned key frame and, per frame, the bytes that differ from it
+// as XOR spans. Switching frames XORs two deltas, so flash and the work per
+// change go with how much of the image changes, not with its size.
+//
+// sprite_draw() writes the buffer directly: it expects the unrotated (R0)
+// buffer every target uses, and ignores u8g2's clip window.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <u8g2.h>
+
+#include "config.h"
+
+typedef struct {
+  uint16_t width;
+  uint16_t height;
+  uint8_t rows;    // byte rows per variant, room for the largest shift
+  uint8_t shifts;  // variants: 1 (aligned only) or 8 (one per y % 8)
+  bool compressed; // bits is the RLE stream of the aligned variant
+  // variant after variant, each `rows` rows of `width` column bytes. when
+  // compressed, a control byte c < 0x80 is followed by c + 1 literal bytes,
+  // c >= 0x80 by one byte that repeats (c & 0x7f) + 2 times. runs go on
+  // across rows.
+  const uint8_t *bits;
+} sprite_t;
+
+typedef enum {
+  SPRITE_COPY,  // replace the covered pixels, clearing where the sprite is 0
+  SPRITE_OR,    // set where the sprite is set (u8g2 draw color 1)
+  SPRITE_CLEAR, // clear where the sprite is set (draw color 0)
+  SPRITE_XOR,   // invert where the sprite is set (draw color 2)
+} sprite_mode_t;
+
+// draw at x, y (top left, may be off screen)
+void sprite_draw(u8g2_t *u8g2, int16_t x, int16_t y, const sprite_t *sprite,
+                 sprite_mode_t mode);
+
+#define SPRITE_DELTA_END 0xff
+
+typedef struct {
+  const sprite_t *key; // aligned
+  uint8_t frames;
+  // per frame, spans of the key frame's rows that differ: byte row, column,
+  // length n, then n bytes to XOR. SPRITE_DELTA_END in place of a row ends
+  // the delta, the key frame's own is empty.
+  const uint8_t *const *deltas;
+} sprite_anim_t;
+
+// draw a frame at x, y, as SPRITE_COPY: the key frame, then its delta applied
+// in place in the buffer
+void sprite_anim_draw(u8g2_t *u8g2, int16_t x, int16_t y,
+                      const sprite_anim_t *anim, uint8_t frame);
+
+// keeps the current frame of an animation decoded, and only applies deltas
+// when the frame changes. draw it with sprite_draw(..., &player->sprite, ...).
+typedef struct {
+  const sprite_anim_t *anim;
+  uint8_t frame;
+  sprite_t sprite; // the current frame, bits points at cache
+  uint8_t cache[DISP_WIDTH * DISP_HEIGHT / 8];
+} sprite_player_t;
+
+// decodes the key frame, the animation must fit the screen
+void sprite_player_init(sprite_player_t *player, const sprite_anim_t *anim);
+void sprite_player_set_frame(sprite_player_t *player, uint8_t frame);
@@ -0,0 +1,81 @@
+#include "telemetry.h"
+
+static struct {
+  uint8_t bytes[TELEMETRY_RING_SIZE];
+  uint32_t head;
+  uint32_t tail;
+  uint16_t dropped;
+} ring;
+
+static uint8_t crc8(const uint8_t *data, size_t len) {
+  uint8_t crc = 0;
+  while (len--) {
+    crc ^= *data++;
+    for (int i = 0; i < 8; i++)
+      crc = crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1;
+  }
+  return crc;
+}
+
+// consistent overhead byte stuffing, returns the encoded length
+static size_t cobs_encode(const uint8_t *in, size_t len, uint8_t *out) {
+  size_t code_at = 0;
+  size_t o = 1;
+  uint8_t code = 1;
+  for (size_t i = 0; i < len; i++) {
+    if (in[i] != 0) {
+      out[o++] = in[i];
+      code++;
+    }
+    if (in[i] == 0 || code == 0xff) {
+      out[code_at] = code;
+      code_at = o++;
+      code = 1;
+    }
+  }
+  out[code_at] = code;
+  return o;
+}
+
+bool telemetry_publish(const void *record, size_t len) {
+  uint8_t raw[TELEMETRY_MAX_RECORD + 1];
+  uint8_t frame[TELEMETRY_MAX_RECORD + 4];
+  if (len > TELEMETRY_MAX_RECORD)
+    return false;
+
+  for (size_t i = 0; i < len; i++)
+    raw[i] = ((const uint8_t *)record)[i];
+  raw[len] = crc8(raw, len);
+  frame[0] = 0;
+  size_t n = 1 + cobs_encode(raw, len + 1, frame + 1);
+  frame[n++] = 0;
+
+  if (TELEMETRY_RING_SIZE - (ring.head - ring.tail) < n) {
+    ring.dropped++;
+    return false;
+  }
+  for (size_t i = 0; i < n; i++)
+    ring.bytes[(ring.head + i) % TELEMETRY_RING_SIZE] = frame[i];
+  ring.head += n;
+  return true;
+}
+
+bool telemetry_room(size_t len) {
+  // worst case frame: two delimiters, crc and one COBS code per 254 bytes
+  return TELEMETRY_RING_SIZE - (ring.head - ring.tail) >= len + 4;
+}
+
+void telemetry_drain() {
+  uint32_t pending = ring.head - ring.tail;
+  if (pending == 0)
+    return;
+  if (pending > TELEMETRY_DRAIN_PER_FRAME)
+    pending = TELEMETRY_DRAIN_PER_FRAME;
+  // contiguous part only, the rest goes next frame
+  uint32_t at = ring.tail % TELEMETRY_RING_SIZE;
+  if (pending > TELEMETRY_RING_SIZE - at)
+    pending = TELEMETRY_RING_SIZE - at;
+  ring.tail += telemetry_output_write(&ring.bytes[at], pending);
+}
+
+uint16_t telemetry_dropped() { return ring.dropped; }
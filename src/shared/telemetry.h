@@ -0,0 +1,155 @@
+// Binary telemetry.
+// Once per second the engine publishes a telemetry_stats_t instead of
+// formatting a log line, trace captures (trace.h) follow as
+// telemetry_trace_t records and a session recorded from the menu as
+// telemetry_input_log_t records. Profile and memory reports go out as
+// telemetry_profile_t and telemetry_memory_t. Records are framed and queued
+// in a byte ring, and the frame loop drains a little of it every frame
+// through telemetry_output_write(), which never blocks: USB CDC on rp2, a
+// file on host. scripts/telemetry.py decodes the stream into CSV or a live view.
+//
+// Framing: 0x00, COBS(record + crc8), 0x00. COBS keeps 0x00 out of the
+// frame, so records can share the stream with printf text; the decoder
+// resyncs on the next 0x00 and passes everything else through as text.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_RING_SIZE 1024 // power of two
+#define TELEMETRY_DRAIN_PER_FRAME 128
+#define TELEMETRY_MAX_RECORD 64
+
+enum {
+  TELEMETRY_RECORD_STATS = 1,
+  TELEMETRY_RECORD_TRACE = 2,
+  TELEMETRY_RECORD_INPUT_LOG_START = 3,
+  TELEMETRY_RECORD_INPUT_LOG = 4,
+  TELEMETRY_RECORD_PROFILE = 5,
+  TELEMETRY_RECORD_MEMORY = 6,
+};
+
+// all fields little endian. keep in sync with scripts/telemetry.py
+typedef struct __attribute__((packed)) {
+  uint8_t type;    // TELEMETRY_RECORD_*
+  uint8_t version; // TELEMETRY_VERSION
+  uint32_t time_ms;
+  uint16_t fps;
+  uint16_t frame_avg_us;
+  uint16_t frame_p99_us;
+  uint16_t frame_max_us;
+  uint16_t synth_avg_load; // % of the buffer budget
+  uint16_t synth_p99_load;
+  uint16_t synth_peak_load;
+  uint16_t synth_overruns;
+  uint16_t synth_underruns;
+  uint16_t notes; // timestamped note-ons in the last second
+  uint16_t note_avg_us;
+  uint16_t note_peak_us;
+  uint8_t battery_level; // %
+  uint8_t power;         // TELEMETRY_POWER_* bits
+  uint16_t midi_dropped;
+  uint16_t input_dropped;
+  uint16_t telemetry_dropped; // records that didn't fit the ring
+} telemetry_stats_t;
+
+#define TELEMETRY_TRACE_EVENTS 6
+
+typedef struct __attribute__((packed)) {
+  uint8_t type;    // TELEMETRY_RECORD_TRACE
+  uint8_t version; // TELEMETRY_VERSION
+  uint8_t capture; // counts up with every trace capture
+  uint8_t core;
+  uint8_t count; // events used
+  struct __attribute__((packed)) {
+    uint32_t time_us;
+    uint8_t id;
+    uint8_t phase;
+    uint16_t arg;
+  } events[TELEMETRY_TRACE_EVENTS];
+} telemetry_trace_t;
+
+#define TELEMETRY_APP_NAME 16 // app names are cut to fit
+
+// the frame profile of an app (profile.h), one record per section, every
+// PROFILE_REPORT_INTERVAL_US and when the app changes
+typedef struct __attribute__((packed)) {
+  uint8_t type;    // TELEMETRY_RECORD_PROFILE
+  uint8_t version; // TELEMETRY_VERSION
+  char app[TELEMETRY_APP_NAME];
+  uint8_t section; // profile_section_t
+  uint16_t frames;
+  uint16_t min_us;
+  uint16_t avg_us;
+  uint16_t p50_us;
+  uint16_t p95_us;
+  uint16_t p99_us;
+  uint16_t max_us;
+} telemetry_profile_t;
+
+// RAM headroom (memory.h) along with each profile. the arena peak is since
+// the last report.
+typedef struct __attribute__((packed)) {
+  uint8_t type;    // TELEMETRY_RECORD_MEMORY
+  uint8_t version; // TELEMETRY_VERSION
+  char app[TELEMETRY_APP_NAME];
+  uint32_t arena_used;
+  uint32_t arena_size;
+  uint32_t arena_peak;
+  uint32_t heap_used;
+  uint32_t heap_peak;
+  uint32_t stack_peak[2]; // per core, 0 if unknown
+  uint32_t stack_size[2];
+} telemetry_memory_t;
+
+// an input log recorded from the menu (input_log.h) goes out once recording
+// stops: a start record, then the entries in order.
+// `scripts/telemetry.py --input-log` writes it to a file for --replay.
+typedef struct __attribute__((packed)) {
+  uint8_t type;    // TELEMETRY_RECORD_INPUT_LOG_START
+  uint8_t version; // TELEMETRY_VERSION
+  char app[32];
+  uint32_t count; // entries to follow
+} telemetry_input_log_start_t;
+
+#define TELEMETRY_INPUT_LOG_ENTRIES 6
+
+typedef struct __attribute__((packed)) {
+  uint8_t type;    // TELEMETRY_RECORD_INPUT_LOG
+  uint8_t version; // TELEMETRY_VERSION
+  uint32_t first;  // index of entries[0] in the log
+  uint8_t count;   // entries used
+  struct __attribute__((packed)) {
+    uint16_t delta;
+    uint8_t button;
+    uint8_t pressed;
+    uint32_t time_us;
+  } entries[TELEMETRY_INPUT_LOG_ENTRIES]; // as input_log_entry_t
+} telemetry_input_log_t;
+
+#define TELEMETRY_POWER_PLUGGED_IN 0x01
+#define TELEMETRY_POWER_CHARGING 0x02
+
+// queue a record, dropped if the ring is full. core0 only
+bool telemetry_publish(const void *record, size_t len);
+
+// true if a record of len bytes fits the ring right now
+bool telemetry_room(size_t len);
+
+// hand up to TELEMETRY_DRAIN_PER_FRAME queued bytes to the output. core0 only
+void telemetry_drain();
+
+// records lost to a full ring so far
+uint16_t telemetry_dropped();
+
+// platform output: write up to len bytes without blocking, return how many
+// were taken. bytes nobody listens to count as taken.
+size_t telemetry_output_write(const uint8_t *data, size_t len);
+
+#if !PICO_ON_DEVICE
+// host only: write the stream to a file, dropped if never opened
+bool telemetry_output_open(const char *path);
+#endif
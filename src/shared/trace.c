@@ -0,0 +1,80 @@
+#include "trace.h"
+
+#if TRACE_ENABLED
+
+#if !PICO_ON_DEVICE
+#include <time.h>
+#endif
+
+#include "telemetry.h"
+
+// records per frame, so a capture doesn't crowd out the stats
+#define TRACE_RECORDS_PER_FRAME 2
+
+trace_t g_trace;
+
+#if !PICO_ON_DEVICE
+_Thread_local uint8_t g_trace_core;
+
+uint32_t trace_time_us() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000ull + ts.tv_nsec / 1000);
+}
+#endif
+
+static uint8_t capture;
+
+void trace_start() {
+  for (int core = 0; core < TRACE_CORES; core++)
+    g_trace.rings[core].tail = g_trace.rings[core].head;
+  capture++;
+  __dmb();
+  g_trace.recording = true;
+}
+
+// send up to one record of a core's events. false if there were none or the
+// telemetry ring is full, the events stay queued then.
+static bool flush_core(uint8_t core) {
+  trace_ring_t *ring = &g_trace.rings[core];
+  uint32_t tail = ring->tail;
+  uint32_t pending = ring->head - tail;
+  if (pending == 0 || !telemetry_room(sizeof(telemetry_trace_t)))
+    return false;
+  __dmb();
+
+  telemetry_trace_t record = {
+      .type = TELEMETRY_RECORD_TRACE,
+      .version = TELEMETRY_VERSION,
+      .capture = capture,
+      .core = core,
+      .count = MIN(pending, TELEMETRY_TRACE_EVENTS),
+  };
+  for (uint8_t i = 0; i < record.count; i++) {
+    const trace_event_t *e = &ring->events[(tail + i) % TRACE_RING_SIZE];
+    record.events[i].time_us = e->time_us;
+    record.events[i].id = e->id;
+    record.events[i].phase = e->phase;
+    record.events[i].arg = e->arg;
+  }
+  if (!telemetry_publish(&record, sizeof(record)))
+    return false;
+  __dmb();
+  ring->tail = tail + record.count;
+  return true;
+}
+
+void trace_flush() {
+  if (g_trace.recording)
+    return; // the capture streams out once it is complete
+  int sent = 0;
+  for (uint8_t core = 0; core < TRACE_CORES; core++) {
+    while (sent < TRACE_RECORDS_PER_FRAME && flush_core(core))
+      sent++;
+  }
+  if (sent == 0 && g_trace.rings[0].head == g_trace.rings[0].tail &&
+      g_trace.rings[1].head == g_trace.rings[1].tail)
+    trace_start();
+}
+
+#endif
@@ -0,0 +1,148 @@
+// Event tracing for both cores.
+// Trace points record begin/end/instant events with a 32-bit µs timestamp
+// into a lock-free ring per core (the core is the only writer, the engine
+// loop on core0 the only reader). A capture runs until either ring is full,
+// then stops so the cores stay in step. The engine streams the events out as
+// telemetry records (telemetry.h) and starts the next capture once both rings
+// are empty. scripts/telemetry.py --trace turns them into Chrome trace JSON
+// for chrome://tracing or Perfetto.
+//
+// Compiled out unless TRACE_ENABLED is 1 (cmake -DTRACE=ON, always on host).
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <hardware/sync.h>
+#include <pico/platform.h>
+#include <pico/time.h>
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 0
+#endif
+
+#define TRACE_CORES 2
+#define TRACE_RING_SIZE 512 // events per core, power of two
+
+// keep in sync with TRACE_NAMES in scripts/telemetry.py
+typedef enum {
+  TRACE_FRAME,         // engine frame, core0
+  TRACE_INPUT,         // button input
+  TRACE_TICKS,         // anims and app ticks of a frame
+  TRACE_APP_FRAME,     // app frame()
+  TRACE_MENU,          // menu_frame()
+  TRACE_DISPLAY,       // display_send_buffer()
+  TRACE_LEDS,          // leds_show()
+  TRACE_SLEEP,         // frame limiter sleep
+  TRACE_APP_ENTER,     // app enter()
+  TRACE_APP_LEAVE,     // app leave()
+  TRACE_SYNTH_BUFFER,  // audio_synth_fill_buffer(), core1
+  TRACE_AUDIO_DMA_IRQ, // audio DMA buffer swap, instant
+  TRACE_SPI_SEND,      // display SPI transfer
+  TRACE_ID_COUNT,
+} trace_id_t;
+
+enum {
+  TRACE_PHASE_BEGIN = 'B',
+  TRACE_PHASE_END = 'E',
+  TRACE_PHASE_INSTANT = 'i',
+};
+
+typedef struct {
+  uint32_t time_us;
+  uint8_t id;    // trace_id_t
+  uint8_t phase; // TRACE_PHASE_*
+  uint16_t arg;
+} trace_event_t;
+
+#if TRACE_ENABLED
+
+typedef struct {
+  trace_event_t events[TRACE_RING_SIZE];
+  volatile uint32_t head; // written by the recording core
+  volatile uint32_t tail; // written by the reader
+} trace_ring_t;
+
+typedef struct {
+  trace_ring_t rings[TRACE_CORES];
+  volatile bool recording;
+} trace_t;
+
+extern trace_t g_trace;
+
+#if !PICO_ON_DEVICE
+// host threads stand in for cores, see trace_set_core()
+extern _Thread_local uint8_t g_trace_core;
+#endif
+
+#if PICO_ON_DEVICE
+static inline uint32_t trace_time_us() { return time_us_32(); }
+#else
+// host only: wall clock, the headless runner's virtual clock stands still
+// while it works
+uint32_t trace_time_us();
+#endif
+
+static inline uint8_t trace_core() {
+#if PICO_ON_DEVICE
+  return get_core_num();
+#else
+  return g_trace_core;
+#endif
+}
+
+static inline void trace_event(uint8_t id, uint8_t phase, uint16_t arg) {
+  if (!g_trace.recording)
+    return;
+#if PICO_ON_DEVICE
+  // irq handlers on the same core write to the same ring
+  uint32_t irq = save_and_disable_interrupts();
+#endif
+  trace_ring_t *ring = &g_trace.rings[trace_core()];
+  uint32_t head = ring->head;
+  if (head - ring->tail < TRACE_RING_SIZE) {
+    ring->events[head % TRACE_RING_SIZE] = (trace_event_t){
+        .time_us = trace_time_us(), .id = id, .phase = phase, .arg = arg};
+    __dmb();
+    ring->head = head + 1;
+  } else {
+    g_trace.recording = false; // capture complete
+  }
+#if PICO_ON_DEVICE
+  restore_interrupts(irq);
+#endif
+}
+
+// host only: which ring the calling thread records into
+static inline void trace_set_core(uint8_t core) {
+#if !PICO_ON_DEVICE
+  g_trace_core = core;
+#endif
+}
+
+void trace_start();
+// stream captured events into telemetry and restart the capture once all
+// are out. core0, once per frame
+void trace_flush();
+
+#else
+
+static inline void trace_event(uint8_t id, uint8_t phase, uint16_t arg) {}
+static inline void trace_set_core(uint8_t core) {}
+static inline void trace_start() {}
+static inline void trace_flush() {}
+
+#endif
+
+static inline void trace_begin(trace_id_t id) {
+  trace_event(id, TRACE_PHASE_BEGIN, 0);
+}
+
+static inline void trace_end(trace_id_t id) {
+  trace_event(id, TRACE_PHASE_END, 0);
+}
+
+static inline void trace_instant(trace_id_t id, uint16_t arg) {
+  trace_event(id, TRACE_PHASE_INSTANT, arg);
+}
@@ -0,0 +1,43 @@
+// bump allocator over a fixed buffer
+// allocations are only ever freed all at once with arena_reset(). peak keeps
+// the high-water mark across resets until arena_reset_peak().
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define ARENA_ALIGN 8
+
+typedef struct {
+  uint8_t *base;
+  uint32_t size;
+  uint32_t used;
+  uint32_t peak;
+} arena_t;
+
+static inline void arena_init(arena_t *arena, void *buffer, uint32_t size) {
+  arena->base = (uint8_t *)buffer;
+  arena->size = size;
+  arena->used = 0;
+  arena->peak = 0;
+}
+
+// zeroed memory, NULL if the arena is full
+static inline void *arena_alloc(arena_t *arena, uint32_t size) {
+  uint32_t at = (arena->used + ARENA_ALIGN - 1) & ~(uint32_t)(ARENA_ALIGN - 1);
+  if (at > arena->size || size > arena->size - at)
+    return NULL;
+  arena->used = at + size;
+  if (arena->used > arena->peak)
+    arena->peak = arena->used;
+  memset(arena->base + at, 0, size);
+  return arena->base + at;
+}
+
+static inline void arena_reset(arena_t *arena) { arena->used = 0; }
+
+static inline void arena_reset_peak(arena_t *arena) {
+  arena->peak = arena->used;
+}
@@ -54,6 +54,10 @@ static inline q1x15 q1x15_sub_unchecked(q1x15 a, q1x15 b) { return a - b; }
 
 // conversions
 
+// compile-time conversion of a float literal [-1.0, +1.0] to q1x15, for use in
+// static initializers. no clamping, keep the input in range.
+#define Q1X15_C(a) ((q1x15)((a) * (float)Q1X15_ONE))
+
 // convert float [-1.0, +1.0] to q1x15
 static inline q1x15 q1x15_f(float a) {
   int32_t v = (int32_t)(a * (float)Q1X15_ONE);
@@ -26,6 +26,10 @@ static inline q1x31 q1x31_clamp_s64(int64_t a) {
   return (q1x31)a;
 }
 
+// compile-time conversion of a float literal [-1.0, +1.0) to q1x31, for use in
+// static initializers. no clamping, keep the input in range.
+#define Q1X31_C(a) ((q1x31)((a) * 2147483647.0))
+
 static inline q1x31 q1x31_f(float a) {
   int64_t v = (int64_t)(a * (float)Q1X31_ONE);
   return q1x31_clamp_s64(v);
@@ -0,0 +1,41 @@
+// single-writer sequence lock.
+// lets one core publish a snapshot struct that another core can copy out
+// without either side blocking. the writer never waits; readers retry if they
+// raced with a write.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <hardware/sync.h>
+
+typedef struct {
+  volatile uint32_t seq; // odd while a write is in progress
+} seqlock_t;
+
+static inline void seqlock_init(seqlock_t *lock) { lock->seq = 0; }
+
+static inline void seqlock_write_begin(seqlock_t *lock) {
+  lock->seq++;
+  __dmb();
+}
+
+static inline void seqlock_write_end(seqlock_t *lock) {
+  __dmb();
+  lock->seq++;
+}
+
+static inline uint32_t seqlock_read_begin(const seqlock_t *lock) {
+  uint32_t seq;
+  while ((seq = lock->seq) & 1u)
+    ; // writer is mid-update, it will be done shortly
+  __dmb();
+  return seq;
+}
+
+// true if the data read since seqlock_read_begin() may be torn
+static inline bool seqlock_read_retry(const seqlock_t *lock, uint32_t seq) {
+  __dmb();
+  return lock->seq != seq;
+}
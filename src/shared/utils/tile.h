@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+// 8x8 tiles in u8g2's vertical-top-lsb layout: one byte per column, bit 0
+// at the top.
+
+// turn a tile a quarter clockwise, the way U8G2_R1 maps a 128x64 buffer onto
+// a 64x128 panel: out[7 - y] bit x = in[x] bit y. a bit transpose on two
+// 32-bit halves (Hacker's Delight 7-3), no per-pixel loop.
+static inline void tile_rotate_r1(const uint8_t in[8], uint8_t out[8]) {
+  uint32_t x, y, t;
+  // rows go in last to first, so the result comes out in column order
+  memcpy(&y, in, 4);
+  memcpy(&x, in + 4, 4);
+
+  t = (x ^ (x >> 7)) & 0x00aa00aau;
+  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00aa00aau;
+  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000ccccu;
+  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000ccccu;
+  y = y ^ t ^ (t << 14);
+  t = (x & 0xf0f0f0f0u) | ((y >> 4) & 0x0f0f0f0fu);
+  y = ((x << 4) & 0xf0f0f0f0u) | (y & 0x0f0f0f0fu);
+  x = __builtin_bswap32(t);
+  y = __builtin_bswap32(y);
+  memcpy(out, &x, 4);
+  memcpy(out + 4, &y, 4);
+}
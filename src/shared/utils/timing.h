@@ -2,15 +2,27 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <pico/time.h>
 
+// Histogram buckets are log spaced: four per octave, exact below 4 µs and
+// within 25% above. the last bucket collects everything from ~3.7 s up.
+#define TI_HIST_SUB_BITS 2
+#define TI_HIST_MAX_US ((1u << 22) - 1)
+#define TI_HIST_BUCKETS 84
+
 // Everything stored in microseconds
 typedef struct {
   absolute_time_t start_time;
   absolute_time_t end_time;
   uint64_t aggregate_time;
   uint32_t count;
+  uint32_t min_us;
+  uint32_t max_us;
+  // histogram mode, see ti_enable_histogram()
+  bool histogram;
+  uint16_t hist[TI_HIST_BUCKETS];
 } TimingInstrumenter;
 
 // Initialize/reset all counters
@@ -19,6 +31,51 @@ static inline void ti_init(TimingInstrumenter *ti) {
   ti->end_time = 0;
   ti->aggregate_time = 0;
   ti->count = 0;
+  ti->min_us = UINT32_MAX;
+  ti->max_us = 0;
+  if (ti->histogram)
+    memset(ti->hist, 0, sizeof(ti->hist));
+}
+
+// Keep a histogram of the samples for percentiles. The tally window should
+// stay under 65535 samples.
+static inline void ti_enable_histogram(TimingInstrumenter *ti) {
+  ti->histogram = true;
+  ti_init(ti);
+}
+
+static inline uint32_t ti_hist_bucket(uint32_t us) {
+  if (us > TI_HIST_MAX_US)
+    us = TI_HIST_MAX_US;
+  if (us < (1u << TI_HIST_SUB_BITS))
+    return us;
+  uint32_t msb = 31 - __builtin_clz(us);
+  return ((msb - TI_HIST_SUB_BITS + 1) << TI_HIST_SUB_BITS) |
+         ((us >> (msb - TI_HIST_SUB_BITS)) & ((1u << TI_HIST_SUB_BITS) - 1));
+}
+
+// smallest value that falls into a bucket
+static inline uint32_t ti_hist_bucket_floor(uint32_t bucket) {
+  if (bucket < (1u << TI_HIST_SUB_BITS))
+    return bucket;
+  uint32_t msb = (bucket >> TI_HIST_SUB_BITS) + TI_HIST_SUB_BITS - 1;
+  return (1u << msb) |
+         ((bucket & ((1u << TI_HIST_SUB_BITS) - 1)) << (msb - TI_HIST_SUB_BITS));
+}
+
+// Add a sample measured elsewhere
+static inline void ti_record(TimingInstrumenter *ti, uint32_t us) {
+  ti->aggregate_time += us;
+  ti->count++;
+  if (us < ti->min_us)
+    ti->min_us = us;
+  if (us > ti->max_us)
+    ti->max_us = us;
+  if (ti->histogram) {
+    uint16_t *bucket = &ti->hist[ti_hist_bucket(us)];
+    if (*bucket != UINT16_MAX)
+      (*bucket)++;
+  }
 }
 
 // Record current timestamp
@@ -29,8 +86,7 @@ static inline void ti_start(TimingInstrumenter *ti) {
 // Stop and accumulate
 static inline void ti_stop(TimingInstrumenter *ti) {
   ti->end_time = get_absolute_time();
-  ti->aggregate_time += absolute_time_diff_us(ti->start_time, ti->end_time);
-  ti->count++;
+  ti_record(ti, absolute_time_diff_us(ti->start_time, ti->end_time));
 }
 
 // Last measured interval (µs)
@@ -38,15 +94,35 @@ static inline uint64_t ti_get_elapsed_us(const TimingInstrumenter *ti) {
   return absolute_time_diff_us(ti->start_time, ti->end_time);
 }
 
+// Percentile (0-100) in µs, from the histogram: the upper end of the bucket
+// it falls in, capped by the largest sample. 0 without samples or histogram.
+static inline uint32_t ti_get_percentile_us(const TimingInstrumenter *ti,
+                                            uint32_t percentile) {
+  if (!ti->histogram || ti->count == 0)
+    return 0;
+  uint32_t rank = (ti->count * percentile + 99) / 100;
+  if (rank == 0)
+    rank = 1;
+  uint32_t seen = 0;
+  for (uint32_t i = 0; i < TI_HIST_BUCKETS; i++) {
+    seen += ti->hist[i];
+    if (seen >= rank) {
+      if (i + 1 == TI_HIST_BUCKETS)
+        return ti->max_us;
+      uint32_t top = ti_hist_bucket_floor(i + 1) - 1;
+      return top < ti->max_us ? top : ti->max_us;
+    }
+  }
+  return ti->max_us;
+}
+
 // Average time in milliseconds.
 // If reset==true, clear the tally after computing.
 static inline double ti_get_average_ms(TimingInstrumenter *ti, bool reset) {
   if (ti->count == 0)
     return 0.0;
   double avg_us = (double)ti->aggregate_time / (double)ti->count;
-  if (reset) {
-    ti->aggregate_time = 0;
-    ti->count = 0;
-  }
+  if (reset)
+    ti_init(ti);
   return avg_us * 1e-3;
 }